@@ -0,0 +1,45 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_BLOB_VIEW_HPP
+#define BRIG_BLOB_VIEW_HPP
+
+#include <brig/blob_t.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace brig {
+
+/*!
+borrowed bytes (driver memory), valid until the next fetch
+*/
+class blob_view {
+  const uint8_t* m_data;
+  size_t m_size;
+
+public:
+  blob_view() : m_data(0), m_size(0)  {}
+  blob_view(const void* data, size_t size) : m_data((const uint8_t*)data), m_size(data? size: 0)  {}
+  explicit blob_view(const blob_t& blob) : m_data(blob.data()), m_size(blob.size())  {}
+  const uint8_t* data() const  { return m_data; }
+  size_t size() const  { return m_size; }
+  bool empty() const  { return m_size == 0; }
+  const uint8_t* begin() const  { return m_data; }
+  const uint8_t* end() const  { return m_data + m_size; }
+  uint8_t operator[](size_t i) const  { return m_data[i]; }
+  blob_t to_blob() const  { return blob_t(begin(), end()); }
+}; // blob_view
+
+} // brig
+
+namespace std {
+
+template <typename CharT, typename TraitsT>
+basic_ostream<CharT, TraitsT>& operator<<(basic_ostream<CharT, TraitsT>& stream, const brig::blob_view& blob)
+{
+  return stream << blob.to_blob();
+}
+
+} // std
+
+#endif // BRIG_BLOB_VIEW_HPP
@@ -0,0 +1,82 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_BOOST_COVER_HPP
+#define BRIG_BOOST_COVER_HPP
+
+#include <algorithm>
+#include <boost/geometry/geometry.hpp>
+#include <brig/boost/correct.hpp>
+#include <brig/boost/detail/clip_visitor.hpp>
+#include <brig/boost/envelope.hpp>
+#include <brig/boost/geometry.hpp>
+#include <brig/global.hpp>
+#include <exception>
+#include <iterator>
+#include <vector>
+
+namespace brig { namespace boost {
+
+/*!
+covering of the geometry with max_boxes boxes at most (the envelope if max_boxes < 2):\n
+* the biggest box is split in halves along its longer side, the halves are shrunk to the clipped geometry\n
+* a box is kept if its halves save less than CoverGainMin of its area\n
+* the envelope is returned if the geometry can not be clipped\n
+*/
+inline std::vector<box> cover(const geometry& geom, size_t max_boxes)
+{
+  using namespace std;
+  const box env(envelope(geom));
+  if (max_boxes < 2) return vector<box>(1, env);
+  vector<box> res(1, env), kept;
+  try
+  {
+    const geometry valid(correct(geom));
+    auto less_area([](const box& a, const box& b)  { return ::boost::geometry::area(a) < ::boost::geometry::area(b); });
+    while (!res.empty() && res.size() + kept.size() < max_boxes)
+    {
+      auto itr(max_element(begin(res), end(res), less_area));
+      const point& min(itr->min_corner());
+      const point& max(itr->max_corner());
+      box halves[2] = {*itr, *itr};
+      if (max.x() - min.x() < max.y() - min.y())
+      {
+        const double ymed((min.y() + max.y()) / 2.);
+        halves[0].max_corner().y(ymed);
+        halves[1].min_corner().y(ymed);
+      }
+      else
+      {
+        const double xmed((min.x() + max.x()) / 2.);
+        halves[0].max_corner().x(xmed);
+        halves[1].min_corner().x(xmed);
+      }
+
+      vector<box> parts;
+      double parts_area(0);
+      for (const auto& half: halves)
+      {
+        detail::clip_visitor visitor(half);
+        ::boost::apply_visitor(visitor, valid);
+        if (!visitor.found) continue;
+        parts.push_back(visitor.res);
+        parts_area += ::boost::geometry::area(visitor.res);
+      }
+
+      if (parts.empty() || !(parts_area < (1. - CoverGainMin) * ::boost::geometry::area(*itr)))
+      {
+        kept.push_back(*itr);
+        res.erase(itr);
+        continue;
+      }
+      *itr = parts.front();
+      if (parts.size() > 1) res.push_back(parts.back());
+    }
+  }
+  catch (const exception&)  { return vector<box>(1, env); }
+  res.insert(end(res), begin(kept), end(kept));
+  return res;
+}
+
+} } // brig::boost
+
+#endif // BRIG_BOOST_COVER_HPP
@@ -0,0 +1,64 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_BOOST_DETAIL_CLIP_VISITOR_HPP
+#define BRIG_BOOST_DETAIL_CLIP_VISITOR_HPP
+
+#include <boost/geometry/geometry.hpp>
+#include <brig/boost/geometry.hpp>
+#include <vector>
+
+namespace brig { namespace boost { namespace detail {
+
+class clip_visitor : public ::boost::static_visitor<> { // envelope of the geometry clipped by the box
+  const box& m_clip;
+  void add(const box& env);
+  template <typename T> void clip_single(const T& r);
+  template <typename T> void clip_multi(const T& r);
+public:
+  bool found;
+  box res;
+
+  explicit clip_visitor(const box& clip) : m_clip(clip), found(false)  {}
+  void operator()(const point& r)  { if (::boost::geometry::covered_by(r, m_clip)) add(box(r, r)); }
+  void operator()(const linestring& r)  { clip_single(r); }
+  void operator()(const polygon& r)  { clip_single(r); }
+  void operator()(const multi_point& r)  { clip_multi(r); }
+  void operator()(const multi_linestring& r)  { clip_multi(r); }
+  void operator()(const multi_polygon& r)  { clip_multi(r); }
+  void operator()(const ::boost::recursive_wrapper<geometry_collection>& r);
+}; // clip_visitor
+
+inline void clip_visitor::add(const box& env)
+{
+  if (found) ::boost::geometry::expand(res, env);
+  else res = env;
+  found = true;
+}
+
+template <typename T>
+void clip_visitor::clip_single(const T& r)
+{
+  std::vector<T> parts;
+  ::boost::geometry::intersection(m_clip, r, parts);
+  for (const auto& part: parts)
+  {
+    box env;
+    ::boost::geometry::envelope(part, env);
+    add(env);
+  }
+}
+
+template <typename T>
+void clip_visitor::clip_multi(const T& r)
+{
+  for (const auto& single: r) (*this)(single);
+}
+
+inline void clip_visitor::operator()(const ::boost::recursive_wrapper<geometry_collection>& r)
+{
+  for (const auto& geom: r.get()) ::boost::apply_visitor(*this, geom);
+} // clip_visitor::
+
+} } } // brig::boost::detail
+
+#endif // BRIG_BOOST_DETAIL_CLIP_VISITOR_HPP
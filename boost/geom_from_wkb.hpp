@@ -4,12 +4,13 @@
 #define BRIG_BOOST_GEOM_FROM_WKB_HPP
 
 #include <brig/blob_t.hpp>
+#include <brig/blob_view.hpp>
 #include <brig/boost/detail/read_geometry.hpp>
 #include <brig/boost/geometry.hpp>
 
 namespace brig { namespace boost {
 
-inline geometry geom_from_wkb(const blob_t& wkb)
+inline geometry geom_from_wkb(const blob_view& wkb)
 {
   auto ptr(wkb.data());
   geometry geom;
@@ -17,6 +18,11 @@ inline geometry geom_from_wkb(const blob_t& wkb)
   return geom;
 }
 
+inline geometry geom_from_wkb(const blob_t& wkb)
+{
+  return geom_from_wkb(blob_view(wkb));
+}
+
 } } // brig::boost
 
 #endif // BRIG_BOOST_GEOM_FROM_WKB_HPP
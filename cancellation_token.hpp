@@ -0,0 +1,103 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_CANCELLATION_TOKEN_HPP
+#define BRIG_CANCELLATION_TOKEN_HPP
+
+#include <atomic>
+#include <boost/utility.hpp>
+#include <brig/detail/deadline_timer.hpp>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace brig {
+
+/*!
+cooperative cancellation of select and exec, copies of a token share its state:\n
+* cancel() may be called from any thread, an expired deadline cancels the token in the thread of detail::deadline_timer\n
+* subscribed actions interrupt blocking calls of drivers, they are run once under the lock of the token\n
+* a cancelled select throws "cancel error", a command of provider::get_command(token) throws the error of its driver\n
+*/
+class cancellation_token {
+  struct state : ::boost::noncopyable {
+    std::atomic<bool> cancelled;
+    std::mutex mut;
+    std::map<size_t, std::function<void()>> actions;
+    size_t next;
+    state() : cancelled(false), next(0)  {}
+  }; // state
+  std::shared_ptr<state> m_st;
+
+  static void cancel(const std::shared_ptr<state>& st);
+
+public:
+  class registration : ::boost::noncopyable {
+    std::weak_ptr<state> m_st;
+    size_t m_id;
+  public:
+    registration() : m_id(0)  {}
+    registration(std::shared_ptr<state> st, size_t id) : m_st(st), m_id(id)  {}
+    registration(registration&& r) : m_st(std::move(r.m_st)), m_id(r.m_id)  { r.m_st.reset(); }
+    ~registration()  { reset(); }
+    void reset(); // waits for the running action
+  }; // registration
+
+  cancellation_token() : m_st(std::make_shared<state>())  {}
+  void cancel()  { cancel(m_st); }
+  bool is_cancelled() const  { return m_st->cancelled; }
+  void check() const  { if (is_cancelled()) throw std::runtime_error("cancel error"); }
+  void set_deadline(std::chrono::steady_clock::time_point deadline);
+  void set_timeout(std::chrono::milliseconds timeout)  { set_deadline(std::chrono::steady_clock::now() + timeout); }
+  registration subscribe(std::function<void()> action) const; // the action is run at once if the token is cancelled
+}; // cancellation_token
+
+inline void cancellation_token::registration::reset()
+{
+  std::shared_ptr<state> st(m_st.lock());
+  m_st.reset();
+  if (!st) return;
+  std::lock_guard<std::mutex> lock(st->mut);
+  st->actions.erase(m_id);
+} // cancellation_token::registration::
+
+inline void cancellation_token::cancel(const std::shared_ptr<state>& st)
+{
+  if (st->cancelled.exchange(true)) return;
+  std::lock_guard<std::mutex> lock(st->mut);
+  for (auto& action: st->actions)
+  {
+    try  { action.second(); }
+    catch (const std::exception&)  {}
+  }
+  st->actions.clear();
+}
+
+inline void cancellation_token::set_deadline(std::chrono::steady_clock::time_point deadline)
+{
+  std::weak_ptr<state> weak(m_st);
+  detail::deadline_timer::singleton().schedule(deadline, [weak]()
+  {
+    std::shared_ptr<state> st(weak.lock());
+    if (st) cancel(st);
+  });
+}
+
+inline cancellation_token::registration cancellation_token::subscribe(std::function<void()> action) const
+{
+  std::lock_guard<std::mutex> lock(m_st->mut);
+  if (m_st->cancelled)
+  {
+    action();
+    return registration();
+  }
+  const size_t id(m_st->next++);
+  m_st->actions[id] = action;
+  return registration(m_st, id);
+} // cancellation_token::
+
+} // brig
+
+#endif // BRIG_CANCELLATION_TOKEN_HPP
@@ -0,0 +1,205 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_COLUMN_BATCH_HPP
+#define BRIG_COLUMN_BATCH_HPP
+
+#include <brig/column_type.hpp>
+#include <brig/detail/batch_visitor.hpp>
+#include <brig/string_cast.hpp>
+#include <brig/variant.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace brig {
+
+/*!
+columnar page of rows:\n
+* Integer - integers, Double - doubles, String / Blob / Geometry (WKB) - offsets (size() + 1 items) and bytes\n
+* the type of a column is Void until its first not null value\n
+* numeric values are stored in null rows too (as zero) in order to keep arrays aligned with row numbers\n
+*/
+struct column_batch {
+  class column {
+    column_type m_type;
+    size_t m_size;
+    std::vector<uint8_t> m_nulls; // bitmap
+    std::vector<int64_t> m_integers;
+    std::vector<double> m_doubles;
+    std::vector<size_t> m_offsets;
+    std::vector<uint8_t> m_bytes;
+
+    bool is_bytes() const  { return column_type::Blob == m_type || column_type::Geometry == m_type || column_type::String == m_type; }
+    void init(column_type type);
+    void to_string();
+    void push_back(bool null);
+
+  public:
+    column() : m_type(column_type::Void), m_size(0)  {}
+    void clear();
+
+    void push_null()  { push_back(true); }
+    void push(int64_t val);
+    void push(double val);
+    void push(column_type type, const void* data, size_t size);
+
+    column_type type() const  { return m_type; }
+    size_t size() const  { return m_size; }
+    bool is_null(size_t row) const  { return (m_nulls[row >> 3] & (1 << (row & 7))) != 0; }
+    const std::vector<uint8_t>& nulls() const  { return m_nulls; }
+    const std::vector<int64_t>& integers() const  { return m_integers; }
+    const std::vector<double>& doubles() const  { return m_doubles; }
+    const std::vector<size_t>& offsets() const  { return m_offsets; }
+    const std::vector<uint8_t>& bytes() const  { return m_bytes; }
+    const uint8_t* data(size_t row) const  { return m_bytes.data() + m_offsets[row]; }
+    size_t length(size_t row) const  { return m_offsets[row + 1] - m_offsets[row]; }
+    variant get(size_t row) const;
+  }; // column
+
+  std::vector<column> columns;
+  size_t rows;
+
+  column_batch() : rows(0)  {}
+  void clear();
+  void push_back(const std::vector<variant>& row);
+}; // column_batch
+
+inline void column_batch::column::init(column_type type)
+{
+  m_type = type;
+  switch (m_type)
+  {
+  case column_type::Void: break;
+  case column_type::Integer: m_integers.assign(m_size, 0); break;
+  case column_type::Double: m_doubles.assign(m_size, 0); break;
+  case column_type::Blob:
+  case column_type::Geometry:
+  case column_type::String: m_offsets.assign(m_size + 1, 0); break;
+  }
+}
+
+inline void column_batch::column::to_string() // mixed types
+{
+  std::vector<std::string> strs;
+  for (size_t row(0); row < m_size; ++row)
+    if (is_null(row)) strs.push_back(std::string());
+    else if (column_type::Integer == m_type) strs.push_back(string_cast<char>(m_integers[row]));
+    else strs.push_back(string_cast<char>(m_doubles[row]));
+  m_integers.clear();
+  m_doubles.clear();
+  m_bytes.clear();
+  m_offsets.assign(1, 0);
+  m_type = column_type::String;
+  for (const auto& str: strs)
+  {
+    m_bytes.insert(m_bytes.end(), str.begin(), str.end());
+    m_offsets.push_back(m_bytes.size());
+  }
+}
+
+inline void column_batch::column::push_back(bool null)
+{
+  if ((m_size >> 3) >= m_nulls.size()) m_nulls.push_back(0);
+  if (null) m_nulls[m_size >> 3] |= uint8_t(1 << (m_size & 7));
+  switch (m_type)
+  {
+  case column_type::Void: break;
+  case column_type::Integer: if (null) m_integers.push_back(0); break;
+  case column_type::Double: if (null) m_doubles.push_back(0); break;
+  case column_type::Blob:
+  case column_type::Geometry:
+  case column_type::String: m_offsets.push_back(m_bytes.size()); break;
+  }
+  ++m_size;
+}
+
+inline void column_batch::column::clear()
+{
+  m_type = column_type::Void;
+  m_size = 0;
+  m_nulls.clear();
+  m_integers.clear();
+  m_doubles.clear();
+  m_offsets.clear();
+  m_bytes.clear();
+}
+
+inline void column_batch::column::push(int64_t val)
+{
+  if (column_type::Void == m_type) init(column_type::Integer);
+  if (column_type::Double == m_type)  { push(double(val)); return; }
+  if (is_bytes())
+  {
+    const std::string str(string_cast<char>(val));
+    push(m_type, str.data(), str.size());
+    return;
+  }
+  m_integers.push_back(val);
+  push_back(false);
+}
+
+inline void column_batch::column::push(double val)
+{
+  if (column_type::Void == m_type) init(column_type::Double);
+  if (column_type::Integer == m_type)
+  {
+    m_doubles.assign(m_integers.begin(), m_integers.end());
+    m_integers.clear();
+    m_type = column_type::Double;
+  }
+  if (is_bytes())
+  {
+    const std::string str(string_cast<char>(val));
+    push(m_type, str.data(), str.size());
+    return;
+  }
+  m_doubles.push_back(val);
+  push_back(false);
+}
+
+inline void column_batch::column::push(column_type type, const void* data, size_t size)
+{
+  if (column_type::Void == m_type) init(type);
+  if (!is_bytes()) to_string();
+  if (size > 0)
+  {
+    const size_t offset(m_bytes.size());
+    m_bytes.resize(offset + size);
+    memcpy(m_bytes.data() + offset, data, size);
+  }
+  push_back(false);
+}
+
+inline variant column_batch::column::get(size_t row) const
+{
+  if (is_null(row)) return null_t();
+  switch (m_type)
+  {
+  case column_type::Void: break;
+  case column_type::Integer: return m_integers[row];
+  case column_type::Double: return m_doubles[row];
+  case column_type::String: return std::string((const char*)data(row), length(row));
+  case column_type::Blob:
+  case column_type::Geometry: return blob_t(data(row), data(row) + length(row));
+  }
+  return null_t();
+} // column_batch::column::
+
+inline void column_batch::clear()
+{
+  rows = 0;
+  for (auto& col: columns) col.clear();
+}
+
+inline void column_batch::push_back(const std::vector<variant>& row)
+{
+  if (rows == 0) columns.resize(row.size());
+  for (size_t i(0); i < row.size(); ++i)
+    ::boost::apply_visitor(detail::batch_visitor<column>(columns[i]), row[i]);
+  ++rows;
+} // column_batch::
+
+} // brig
+
+#endif // BRIG_COLUMN_BATCH_HPP
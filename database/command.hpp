@@ -5,6 +5,7 @@
 
 #include <brig/column_def.hpp>
 #include <brig/database/dbms.hpp>
+#include <brig/database/fetch_stats.hpp>
 #include <brig/rowset.hpp>
 #include <string>
 #include <vector>
@@ -17,11 +18,13 @@ struct command : rowset {
 
   virtual void set_autocommit(bool autocommit) = 0;
   virtual void commit() = 0;
+  virtual void reset()  { set_autocommit(false); set_autocommit(true); } // before reuse, discards a transaction
 
   virtual DBMS system() = 0;
   virtual std::string sql_param(size_t /*order*/)  { return "?"; }
   virtual bool readable_geom()  { return false; }
   virtual bool writable_geom()  { return false; }
+  virtual fetch_stats get_fetch_stats()  { return fetch_stats(); }
 }; // command
 
 } } // brig::database
@@ -20,11 +20,13 @@ struct binding_visitor : ::boost::static_visitor<int> {
   int operator()(int64_t v) const  { return lib::singleton().p_cci_bind_param(req, i, CCI_A_TYPE_BIGINT, &v, type != CCI_U_TYPE_NULL? type: CCI_U_TYPE_BIGINT, 0); }
   int operator()(float v) const  { return lib::singleton().p_cci_bind_param(req, i, CCI_A_TYPE_FLOAT, &v, type != CCI_U_TYPE_NULL? type: CCI_U_TYPE_FLOAT, 0); }
   int operator()(double v) const  { return lib::singleton().p_cci_bind_param(req, i, CCI_A_TYPE_DOUBLE, &v, type != CCI_U_TYPE_NULL? type: CCI_U_TYPE_DOUBLE, 0); }
-  int operator()(const blob_t& r) const;
+  int operator()(const blob_t& r) const  { return operator()(blob_view(r)); }
   int operator()(const std::string& r) const  { return lib::singleton().p_cci_bind_param(req, i, CCI_A_TYPE_STR, (void*)r.c_str(), type != CCI_U_TYPE_NULL? type: CCI_U_TYPE_STRING, CCI_BIND_PTR); }
+  int operator()(const blob_view& r) const;
+  int operator()(const string_view& r) const  { const std::string str(r.to_string()); return lib::singleton().p_cci_bind_param(req, i, CCI_A_TYPE_STR, (void*)str.c_str(), type != CCI_U_TYPE_NULL? type: CCI_U_TYPE_STRING, 0); }
 }; // binding_visitor
 
-inline int binding_visitor::operator()(const blob_t& r) const
+inline int binding_visitor::operator()(const blob_view& r) const
 {
   T_CCI_BIT bit;
   bit.buf = (char*)r.data();
@@ -30,6 +30,7 @@ public:
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
   void set_autocommit(bool autocommit) override;
+  void reset() override  { set_autocommit(true); } // the transaction state is known locally
   void commit() override;
   DBMS system() override  { return DBMS::CUBRID; }
 }; // command
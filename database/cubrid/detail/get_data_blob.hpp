@@ -6,6 +6,7 @@
 #include <brig/blob_t.hpp>
 #include <brig/database/cubrid/detail/get_data.hpp>
 #include <brig/database/cubrid/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/variant.hpp>
 #include <cstring>
 
@@ -24,8 +25,7 @@ inline int get_data_blob::operator()(int req, size_t col, variant& var)
     var = null_t();
   else
   {
-    var = blob_t();
-    blob_t& blob(::boost::get<blob_t>(var));
+    blob_t& blob(brig::detail::recycle<blob_t>(var));
     blob.resize(data.size);
     if (!blob.empty()) memcpy(blob.data(), data.buf, data.size);
   }
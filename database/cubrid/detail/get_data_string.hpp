@@ -5,6 +5,7 @@
 
 #include <brig/database/cubrid/detail/get_data.hpp>
 #include <brig/database/cubrid/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/variant.hpp>
 #include <string>
 
@@ -25,8 +26,7 @@ inline int get_data_string::operator()(int req, size_t col, variant& var)
     var = null_t();
   else
   {
-    var = string();
-    string& str(::boost::get<string>(var));
+    string& str(brig::detail::recycle<string>(var));
     str = data;
   }
   return r;
@@ -0,0 +1,182 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_DEFERRED_ROWSET_HPP
+#define BRIG_DATABASE_DETAIL_DEFERRED_ROWSET_HPP
+
+#include <algorithm>
+#include <brig/column_def.hpp>
+#include <brig/database/command.hpp>
+#include <brig/detail/type_visitor.hpp>
+#include <brig/global.hpp>
+#include <brig/rowset.hpp>
+#include <brig/string_cast.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace brig { namespace database { namespace detail {
+
+/*!
+two-phase fetch: the light command brings keys and small columns of a page of DeferredBatchSize rows,
+heavy columns of the rest of the page are selected by keys (sql - heavy columns after keys, DeferredBatchSize groups of key parameters)
+on the first access: fetch() or lazy_row::get() of a heavy column; rows passed by fetch_lazy() without the access are never selected
+*/
+class deferred_rowset : public rowset {
+  class reader : public column_reader {
+    deferred_rowset& m_rs;
+  public:
+    explicit reader(deferred_rowset& rs) : m_rs(rs)  {}
+    size_t size() override  { return m_rs.m_cols.size(); }
+    column_type type(size_t col) override  { return ::boost::apply_visitor(brig::detail::type_visitor(), m_rs.value(col)); }
+    void read(size_t col, variant& var) override  { var = m_rs.value(col); }
+  }; // reader
+
+  std::shared_ptr<command> m_light, m_heavy;
+  std::function<std::shared_ptr<command>()> m_allocate;
+  std::mutex m_mut; // m_heavy is allocated on demand and read by cancel()
+  std::vector<std::string> m_names;
+  std::vector<std::pair<bool, size_t>> m_cols; // heavy, index in the light or the heavy row
+  std::vector<size_t> m_keys; // positions of keys in the light row
+  std::string m_sql;
+  std::vector<column_def> m_params; // key columns
+  std::vector<std::vector<variant>> m_page, m_heavy_page;
+  size_t m_count, m_pos, m_loaded; // rows in the page, the next row, the first row with heavy columns
+  reader m_reader;
+
+  static std::string key(const std::vector<variant>& row, const std::vector<size_t>& positions);
+  bool next();
+  void load();
+  variant& value(size_t col);
+
+public:
+  deferred_rowset
+    ( std::shared_ptr<command> light
+    , std::function<std::shared_ptr<command>()> allocate
+    , const std::vector<std::string>& names
+    , const std::vector<std::pair<bool, size_t>>& cols // heavy, index
+    , const std::vector<size_t>& keys
+    , const std::string& sql
+    , const std::vector<column_def>& params
+    );
+  std::vector<std::string> columns() override  { return m_names; }
+  bool fetch(std::vector<variant>& row) override;
+  bool fetch_lazy(lazy_row& row) override;
+  void cancel() override;
+}; // deferred_rowset
+
+inline deferred_rowset::deferred_rowset
+  ( std::shared_ptr<command> light
+  , std::function<std::shared_ptr<command>()> allocate
+  , const std::vector<std::string>& names
+  , const std::vector<std::pair<bool, size_t>>& cols
+  , const std::vector<size_t>& keys
+  , const std::string& sql
+  , const std::vector<column_def>& params
+  )
+  : m_light(light), m_allocate(allocate), m_names(names), m_cols(cols), m_keys(keys), m_sql(sql), m_params(params), m_page(DeferredBatchSize), m_heavy_page(DeferredBatchSize), m_count(0), m_pos(0), m_loaded(0), m_reader(*this)
+{
+}
+
+inline std::string deferred_rowset::key(const std::vector<variant>& row, const std::vector<size_t>& positions)
+{
+  std::string res;
+  for (size_t pos: positions) res += string_cast<char>(row[pos]) + '\n';
+  return res;
+}
+
+inline bool deferred_rowset::next()
+{
+  if (m_pos == m_count)
+  {
+    m_count = 0;
+    m_pos = 0;
+    while (m_count < m_page.size() && m_light->fetch(m_page[m_count])) ++m_count;
+    m_loaded = m_count;
+    if (m_count == 0) return false;
+  }
+  ++m_pos;
+  return true;
+}
+
+inline void deferred_rowset::load()
+{
+  using namespace std;
+  const size_t first(m_pos - 1);
+  if (m_loaded <= first) return;
+
+  vector<column_def> params;
+  for (size_t i(first); i < first + DeferredBatchSize; ++i)
+  {
+    const vector<variant>& row(m_page[min<>(i, m_count - 1)]); // the last key is repeated, the text of the statement is stable
+    for (size_t k(0); k < m_keys.size(); ++k)
+    {
+      params.push_back(m_params[k]);
+      params.back().query_value = row[m_keys[k]];
+    }
+  }
+
+  unordered_map<string, size_t> rows;
+  for (size_t i(first); i < m_count; ++i) rows[key(m_page[i], m_keys)] = i;
+
+  shared_ptr<command> cmd;
+  {
+    lock_guard<mutex> lock(m_mut);
+    if (!m_heavy) m_heavy = m_allocate();
+    cmd = m_heavy;
+  }
+  cmd->exec(m_sql, params);
+
+  vector<size_t> positions;
+  for (size_t k(0); k < m_keys.size(); ++k) positions.push_back(k);
+  const size_t heavy(count_if(begin(m_cols), end(m_cols), [](const pair<bool, size_t>& col){ return col.first; }));
+  for (size_t i(first); i < m_count; ++i) m_heavy_page[i].assign(heavy, null_t());
+  vector<variant> row;
+  while (cmd->fetch(row))
+  {
+    auto iter(rows.find(key(row, positions)));
+    if (iter == rows.end()) continue;
+    vector<variant>& dst(m_heavy_page[iter->second]);
+    for (size_t j(0); j < heavy; ++j) swap(dst[j], row[m_keys.size() + j]);
+  }
+  m_loaded = first;
+}
+
+inline variant& deferred_rowset::value(size_t col)
+{
+  if (!m_cols[col].first) return m_page[m_pos - 1][m_cols[col].second];
+  load();
+  return m_heavy_page[m_pos - 1][m_cols[col].second];
+}
+
+inline bool deferred_rowset::fetch(std::vector<variant>& row)
+{
+  using namespace std;
+  if (!next()) return false;
+  if (any_of(begin(m_cols), end(m_cols), [](const pair<bool, size_t>& col){ return col.first; })) load(); // before keys are moved out of the page
+  row.resize(m_cols.size());
+  for (size_t i(0); i < m_cols.size(); ++i) swap(row[i], value(i)); // each row is served once
+  return true;
+}
+
+inline bool deferred_rowset::fetch_lazy(lazy_row& row)
+{
+  if (!next()) return false;
+  row.reset(m_reader);
+  return true;
+}
+
+inline void deferred_rowset::cancel()
+{
+  m_light->cancel();
+  std::lock_guard<std::mutex> lock(m_mut);
+  if (m_heavy) m_heavy->cancel();
+} // deferred_rowset::
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_DEFERRED_ROWSET_HPP
@@ -9,6 +9,12 @@
 #include <brig/pyramid_def.hpp>
 #include <brig/string_cast.hpp>
 #include <brig/table_def.hpp>
+#include <cstdint>
+#include <ios>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace brig { namespace database { namespace detail {
 
@@ -27,6 +33,9 @@ struct dialect {
   virtual std::string sql_indexed_columns(const identifier& tbl) = 0;
   virtual std::string sql_spatial_detail(const table_def& tbl, const std::string& col) = 0;
   virtual column_type get_type(const identifier& type_lcase, int scale) = 0;
+  virtual std::string sql_columns_bulk(const std::vector<identifier>& /*tbls*/)  { return ""; } // empty is returned if not supported, otherwise rows of sql_columns() prefixed with table schema and name
+  virtual std::string sql_indexed_columns_bulk(const std::vector<identifier>& /*tbls*/)  { return ""; } // rows of sql_indexed_columns() prefixed with table schema and name
+  virtual std::string sql_spatial_details_bulk(const std::vector<table_def>& /*tbls*/)  { return ""; } // rows of sql_spatial_detail() prefixed with table schema, name and column
 
   virtual std::string sql_extent(const table_def& tbl, const std::string& col) = 0; // 1 - metadata, 2 - geodetic (no sql), 3 - aggregate
 
@@ -50,10 +59,19 @@ struct dialect {
   virtual bool need_to_normalize_hemisphere(const column_def& /*col*/)  { return false; }
   virtual void sql_intersect
     ( command* /*cmd*/, const table_def& /*tbl*/, const std::string& /*col*/, const std::vector<boost::box>& /*boxes*/
-    , std::string& /*sql*/, std::vector<column_def>& /*keys*/
+    , std::string& /*sql*/, std::vector<column_def>& /*keys*/, std::vector<column_def>& /*params*/
     )
     {}
   virtual std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) = 0;
+  virtual std::string sql_intersect(command* /*cmd*/, const table_def& tbl, const std::string& col, const boost::box& box, std::vector<column_def>& /*params*/)  { return sql_intersect(tbl, col, box); } // coordinates are bound if supported, the select text does not depend on the box
+  std::vector<std::string> sql_box(const boost::box& box); // xmin, ymin, xmax, ymax
+  std::vector<std::string> sql_box(command* cmd, const boost::box& box, std::vector<column_def>& params);
+
+  virtual std::string sql_row_count(const table_def& /*tbl*/)  { return ""; } // empty is returned if not supported, otherwise the estimate from statistics
+  virtual std::string sql_partition_bounds(const table_def& /*tbl*/)  { return ""; } // empty is returned if not supported, otherwise min and max of the partition key
+  virtual std::string sql_partition(int64_t /*lower*/, int64_t /*upper*/)  { return ""; } // [lower, upper), numeric limits mean unbounded
+  virtual std::string sql_export_snapshot()  { return ""; } // empty is returned if not supported
+  virtual void sql_import_snapshot(const std::string& /*snapshot*/, std::vector<std::string>& /*sql*/)  {}
 }; // dialect
 
 inline std::string dialect::sql_identifier(const identifier& id)
@@ -61,6 +79,36 @@ inline std::string dialect::sql_identifier(const identifier& id)
   return id.schema.empty()? sql_identifier(id.name): (sql_identifier(id.schema) + "." + sql_identifier(id.name));
 }
 
+inline std::vector<std::string> dialect::sql_box(const boost::box& box)
+{
+  using namespace std;
+  const double coords[] = {box.min_corner().get<0>(), box.min_corner().get<1>(), box.max_corner().get<0>(), box.max_corner().get<1>()};
+  vector<string> res;
+  for (double coord: coords)
+  {
+    ostringstream stream; stream.imbue(locale::classic()); stream << scientific; stream.precision(17);
+    stream << coord;
+    res.push_back(stream.str());
+  }
+  return res;
+}
+
+inline std::vector<std::string> dialect::sql_box(command* cmd, const boost::box& box, std::vector<column_def>& params)
+{
+  using namespace std;
+  const double coords[] = {box.min_corner().get<0>(), box.min_corner().get<1>(), box.max_corner().get<0>(), box.max_corner().get<1>()};
+  vector<string> res;
+  for (double coord: coords)
+  {
+    column_def param;
+    param.type = column_type::Double;
+    param.query_value = coord;
+    res.push_back(sql_parameter(cmd, param, params.size()));
+    params.push_back(param);
+  }
+  return res;
+}
+
 inline table_def dialect::fit_table(const table_def& tbl, const std::string& schema)
 {
   table_def res;
@@ -10,10 +10,7 @@
 #include <brig/string_cast.hpp>
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
-#include <ios>
 #include <iterator>
-#include <locale>
-#include <sstream>
 #include <stdexcept>
 
 namespace brig { namespace database { namespace detail {
@@ -42,7 +39,11 @@ struct dialect_mysql : dialect {
   std::string sql_parameter(command* cmd, const column_def& param, size_t order) override;
   std::string sql_column(command* cmd, const column_def& col) override;
   void sql_limit(int rows, std::string& sql_infix, std::string& sql_counter, std::string& sql_suffix) override;
-  std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) override;
+  std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) override  { return sql_intersect(tbl, col, sql_box(box)); }
+  std::string sql_intersect(command* cmd, const table_def& tbl, const std::string& col, const boost::box& box, std::vector<column_def>& params) override  { return sql_intersect(tbl, col, sql_box(cmd, box, params)); }
+  std::string sql_intersect(const table_def& tbl, const std::string& col, const std::vector<std::string>& box); // coordinates SQL
+
+  std::string sql_row_count(const table_def& tbl) override  { return "SELECT TABLE_ROWS FROM INFORMATION_SCHEMA.TABLES WHERE TABLE_SCHEMA = '" + tbl.id.schema + "' AND TABLE_NAME = '" + tbl.id.name + "'"; }
 }; // dialect_mysql
 
 inline std::string dialect_mysql::sql_tables()
@@ -167,14 +168,9 @@ inline void dialect_mysql::sql_limit(int rows, std::string&, std::string&, std::
   sql_suffix = "LIMIT " + string_cast<char>(rows);
 }
 
-inline std::string dialect_mysql::sql_intersect(const table_def&, const std::string& col, const boost::box& box)
+inline std::string dialect_mysql::sql_intersect(const table_def&, const std::string& col, const std::vector<std::string>& box)
 {
-  using namespace std;
-
-  const double xmin(box.min_corner().get<0>()), ymin(box.min_corner().get<1>()), xmax(box.max_corner().get<0>()), ymax(box.max_corner().get<1>());
-  ostringstream stream; stream.imbue(locale::classic()); stream << scientific; stream.precision(17);
-  stream << "MBRIntersects(Envelope(LineString(Point(" << xmin << ", " << ymin << "), Point(" << xmax << ", " << ymax << "))), " << sql_identifier(col) << ")";
-  return stream.str();
+  return "MBRIntersects(Envelope(LineString(Point(" + box[0] + ", " + box[1] + "), Point(" + box[2] + ", " + box[3] + "))), " + sql_identifier(col) + ")";
 } // dialect_mysql::
 
 } } } // brig::database::detail
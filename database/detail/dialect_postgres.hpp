@@ -9,9 +9,7 @@
 #include <brig/database/detail/is_ogc_type.hpp>
 #include <brig/global.hpp>
 #include <brig/string_cast.hpp>
-#include <ios>
-#include <locale>
-#include <sstream>
+#include <limits>
 #include <stdexcept>
 
 namespace brig { namespace database { namespace detail {
@@ -27,6 +25,10 @@ struct dialect_postgres : dialect {
   std::string sql_indexed_columns(const identifier& tbl) override;
   std::string sql_spatial_detail(const table_def& tbl, const std::string& col) override;
   column_type get_type(const identifier& type_lcase, int scale) override;
+  std::string sql_columns_bulk(const std::vector<identifier>& tbls) override;
+  std::string sql_indexed_columns_bulk(const std::vector<identifier>& tbls) override;
+  std::string sql_spatial_details_bulk(const std::vector<table_def>& tbls) override;
+  std::string sql_table_list(const std::vector<identifier>& tbls);
 
   std::string sql_extent(const table_def& tbl, const std::string& col) override;
 
@@ -43,7 +45,15 @@ struct dialect_postgres : dialect {
   std::string sql_column(command* cmd, const column_def& col) override;
   void sql_limit(int rows, std::string& sql_infix, std::string& sql_counter, std::string& sql_suffix) override;
   bool need_to_normalize_hemisphere(const column_def& col) override;
-  std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) override;
+  std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) override  { return sql_intersect(tbl, col, sql_box(box)); }
+  std::string sql_intersect(command* cmd, const table_def& tbl, const std::string& col, const boost::box& box, std::vector<column_def>& params) override  { return sql_intersect(tbl, col, sql_box(cmd, box, params)); }
+  std::string sql_intersect(const table_def& tbl, const std::string& col, const std::vector<std::string>& box); // coordinates SQL
+
+  std::string sql_row_count(const table_def& tbl) override  { return "SELECT reltuples FROM pg_class WHERE oid = '" + sql_identifier(tbl.id) + "'::regclass"; } // negative if never analyzed
+  std::string sql_partition_bounds(const table_def& tbl) override  { return "SELECT 0, pg_relation_size('" + sql_identifier(tbl.id) + "') / current_setting('block_size')::int"; } // pages
+  std::string sql_partition(int64_t lower, int64_t upper) override;
+  std::string sql_export_snapshot() override  { return "SELECT pg_export_snapshot()"; }
+  void sql_import_snapshot(const std::string& snapshot, std::vector<std::string>& sql) override;
 }; // dialect_postgres
 
 inline std::string dialect_postgres::sql_tables()
@@ -115,6 +125,87 @@ LEFT JOIN PUBLIC.SPATIAL_REF_SYS s ON c.SRID = s.SRID";
   throw std::runtime_error("datatype error");
 }
 
+inline std::string dialect_postgres::sql_table_list(const std::vector<identifier>& tbls)
+{
+  std::string res;
+  for (const auto& tbl: tbls) res += std::string(res.empty()? "": ", ") + "('" + tbl.schema + "', '" + tbl.name + "')";
+  return "(" + res + ")";
+}
+
+inline std::string dialect_postgres::sql_columns_bulk(const std::vector<identifier>& tbls)
+{
+  return "\
+SELECT \
+  TABLE_SCHEMA \
+, TABLE_NAME \
+, COLUMN_NAME \
+, (CASE DATA_TYPE WHEN 'USER-DEFINED' THEN DATA_TYPE ELSE '' END) \
+, (CASE DATA_TYPE WHEN 'USER-DEFINED' THEN UDT_NAME ELSE DATA_TYPE END) \
+, CHARACTER_MAXIMUM_LENGTH \
+, NUMERIC_SCALE \
+, (CASE IS_NULLABLE WHEN 'NO' THEN 1 ELSE 0 END) \
+FROM INFORMATION_SCHEMA.COLUMNS \
+WHERE (TABLE_SCHEMA, TABLE_NAME) IN " + sql_table_list(tbls) + " \
+ORDER BY TABLE_SCHEMA, TABLE_NAME, ORDINAL_POSITION";
+}
+
+inline std::string dialect_postgres::sql_indexed_columns_bulk(const std::vector<identifier>& tbls)
+{
+  return "\
+SELECT scm, tbl_name, scm, name, pri, unq, m.amname = 'gist', a.attname, opt & 1 FROM \
+(SELECT y.*, y.keys[gs] AS key, y.opts[gs] AS opt FROM \
+ (SELECT x.*, generate_series(x.lb, x.ub) AS gs FROM \
+  (SELECT i.indisprimary AS pri, i.indisunique AS unq, i.indkey AS keys, i.indoption opts, array_lower(i.indkey, 1) AS lb, array_upper(i.indkey, 1) AS ub, o.relname AS name, o.relam AS mth, t.oid tbl, t.relname AS tbl_name, s.nspname AS scm FROM \
+   pg_catalog.pg_index i, pg_catalog.pg_class o, pg_catalog.pg_class t, pg_catalog.pg_namespace s \
+   WHERE i.indexrelid = o.oid AND i.indrelid = t.oid AND t.relnamespace = s.oid AND (s.nspname::text, t.relname::text) IN " + sql_table_list(tbls) + " \
+  ) AS x \
+ ) AS y \
+) AS z \
+, pg_catalog.pg_am m \
+, pg_catalog.pg_attribute a \
+WHERE m.oid = mth AND a.attrelid = tbl AND a.attnum = key \
+ORDER BY scm, tbl_name, pri DESC, name, gs";
+}
+
+inline std::string dialect_postgres::sql_spatial_details_bulk(const std::vector<table_def>& tbls)
+{
+  using namespace std;
+
+  vector<identifier> geometry_tbls, geography_tbls, raster_tbls;
+  for (const auto& tbl: tbls)
+  {
+    bool geometry(false), geography(false), raster(false);
+    for (const auto& col: tbl.columns)
+      if (column_type::Geometry == col.type)
+      {
+        geometry |= col.type_lcase.name.compare("geometry") == 0;
+        geography |= col.type_lcase.name.compare("geography") == 0;
+        raster |= col.type_lcase.name.compare("raster") == 0;
+      }
+    if (geometry) geometry_tbls.push_back(tbl.id);
+    if (geography) geography_tbls.push_back(tbl.id);
+    if (raster) raster_tbls.push_back(tbl.id);
+  }
+
+  vector<string> sql;
+  if (!geometry_tbls.empty()) sql.push_back("\
+SELECT c.F_TABLE_SCHEMA::text, c.F_TABLE_NAME::text, c.F_GEOMETRY_COLUMN::text, c.SRID, (CASE s.AUTH_NAME WHEN 'EPSG' THEN s.AUTH_SRID ELSE NULL END) epsg, c.TYPE::text \
+FROM PUBLIC.GEOMETRY_COLUMNS c LEFT JOIN PUBLIC.SPATIAL_REF_SYS s ON c.SRID = s.SRID \
+WHERE (c.F_TABLE_SCHEMA::text, c.F_TABLE_NAME::text) IN " + sql_table_list(geometry_tbls));
+  if (!geography_tbls.empty()) sql.push_back("\
+SELECT c.F_TABLE_SCHEMA::text, c.F_TABLE_NAME::text, c.F_GEOGRAPHY_COLUMN::text, c.SRID, (CASE s.AUTH_NAME WHEN 'EPSG' THEN s.AUTH_SRID ELSE NULL END) epsg, c.TYPE::text \
+FROM PUBLIC.GEOGRAPHY_COLUMNS c LEFT JOIN PUBLIC.SPATIAL_REF_SYS s ON c.SRID = s.SRID \
+WHERE (c.F_TABLE_SCHEMA::text, c.F_TABLE_NAME::text) IN " + sql_table_list(geography_tbls));
+  if (!raster_tbls.empty()) sql.push_back("\
+SELECT c.R_TABLE_SCHEMA::text, c.R_TABLE_NAME::text, c.R_RASTER_COLUMN::text, c.SRID, (CASE s.AUTH_NAME WHEN 'EPSG' THEN s.AUTH_SRID ELSE NULL END) epsg, NULL::text \
+FROM PUBLIC.RASTER_COLUMNS c LEFT JOIN PUBLIC.SPATIAL_REF_SYS s ON c.SRID = s.SRID \
+WHERE (c.R_TABLE_SCHEMA::text, c.R_TABLE_NAME::text) IN " + sql_table_list(raster_tbls));
+
+  string res;
+  for (const auto& str: sql) res += (res.empty()? "": " UNION ALL ") + str;
+  return res;
+}
+
 inline column_type dialect_postgres::get_type(const identifier& type_lcase, int scale)
 {
   using namespace std;
@@ -284,27 +375,40 @@ inline bool dialect_postgres::need_to_normalize_hemisphere(const column_def& col
   return col.type_lcase.name.compare("geography") == 0;
 }
 
-inline std::string dialect_postgres::sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box)
+inline std::string dialect_postgres::sql_intersect(const table_def& tbl, const std::string& col, const std::vector<std::string>& box)
 {
   using namespace std;
 
-  const double xmin(box.min_corner().get<0>()), ymin(box.min_corner().get<1>()), xmax(box.max_corner().get<0>()), ymax(box.max_corner().get<1>());
   auto col_def(tbl[col]);
   bool geography(false), raster(false);
   if (col_def->type_lcase.name.compare("raster") == 0) raster = true;
   else if (col_def->type_lcase.name.compare("geography") == 0) geography = true;
   else if (col_def->type_lcase.name.compare("geometry") != 0) throw runtime_error("datatype error");
   if (geography && col_def->srid != 4326) throw runtime_error("SRID error");
-  ostringstream stream; stream.imbue(locale::classic()); stream << scientific; stream.precision(17);
-
-  if (raster) stream << "ST_Envelope(";
-  stream << sql_identifier(col);
-  if (raster) stream << ")";
-  stream << " && ";
-  if (geography) stream << "ST_GeogFromWKB(ST_AsBinary(";
-  stream << "ST_SetSRID(ST_MakeBox2D(ST_Point(" << xmin << ", " << ymin << "), ST_Point(" << xmax << ", " << ymax << ")), " << col_def->srid << ")";
-  if (geography) stream << "))";
-  return stream.str();
+
+  string sql;
+  if (raster) sql += "ST_Envelope(";
+  sql += sql_identifier(col);
+  if (raster) sql += ")";
+  sql += " && ";
+  if (geography) sql += "ST_GeogFromWKB(ST_AsBinary(";
+  sql += "ST_SetSRID(ST_MakeBox2D(ST_Point(" + box[0] + ", " + box[1] + "), ST_Point(" + box[2] + ", " + box[3] + ")), " + string_cast<char>(col_def->srid) + ")";
+  if (geography) sql += "))";
+  return sql;
+}
+
+inline std::string dialect_postgres::sql_partition(int64_t lower, int64_t upper)
+{
+  std::string sql;
+  if (lower != std::numeric_limits<int64_t>::min()) sql += "ctid >= '(" + string_cast<char>(lower) + ",0)'::tid";
+  if (upper != std::numeric_limits<int64_t>::max()) sql += std::string(sql.empty()? "": " AND ") + "ctid < '(" + string_cast<char>(upper) + ",0)'::tid";
+  return sql.empty()? "1 = 1": sql;
+}
+
+inline void dialect_postgres::sql_import_snapshot(const std::string& snapshot, std::vector<std::string>& sql)
+{
+  sql.push_back("SET TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+  sql.push_back("SET TRANSACTION SNAPSHOT '" + snapshot + "'");
 } // dialect_postgres::
 
 } } } // brig::database::detail
@@ -12,10 +12,8 @@
 #include <brig/string_cast.hpp>
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
-#include <ios>
 #include <iterator>
-#include <locale>
-#include <sstream>
+#include <limits>
 #include <stdexcept>
 
 namespace brig { namespace database { namespace detail {
@@ -50,8 +48,14 @@ struct dialect_sqlite : dialect {
   std::string sql_parameter(command* cmd, const column_def& param, size_t order) override;
   std::string sql_column(command* cmd, const column_def& col) override;
   void sql_limit(int rows, std::string& sql_infix, std::string& sql_counter, std::string& sql_suffix) override;
-  void sql_intersect(command* cmd, const table_def& tbl, const std::string& col, const std::vector<boost::box>& boxes, std::string& sql, std::vector<column_def>& keys) override;
-  std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) override;
+  void sql_intersect(command* cmd, const table_def& tbl, const std::string& col, const std::vector<boost::box>& boxes, std::string& sql, std::vector<column_def>& keys, std::vector<column_def>& params) override;
+  std::string sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box) override  { return sql_intersect(tbl, col, sql_box(box)); }
+  std::string sql_intersect(command* cmd, const table_def& tbl, const std::string& col, const boost::box& box, std::vector<column_def>& params) override  { return sql_intersect(tbl, col, sql_box(cmd, box, params)); }
+  std::string sql_intersect(const table_def& tbl, const std::string& col, const std::vector<std::string>& box); // coordinates SQL
+
+  std::string sql_row_count(const table_def& tbl) override  { return "SELECT MAX(rowid) FROM " + sql_identifier(tbl.id.name); } // no scan
+  std::string sql_partition_bounds(const table_def& tbl) override  { return "SELECT MIN(rowid), MAX(rowid) FROM " + sql_identifier(tbl.id.name); }
+  std::string sql_partition(int64_t lower, int64_t upper) override;
 }; // dialect_sqlite
 
 inline std::string dialect_sqlite::sql_tables()
@@ -195,7 +199,7 @@ inline void dialect_sqlite::sql_limit(int rows, std::string&, std::string&, std:
   sql_suffix = "LIMIT " + string_cast<char>(rows);
 }
 
-inline void dialect_sqlite::sql_intersect(command*, const table_def& tbl, const std::string& col, const std::vector<boost::box>& boxes, std::string& sql, std::vector<column_def>& keys)
+inline void dialect_sqlite::sql_intersect(command* cmd, const table_def& tbl, const std::string& col, const std::vector<boost::box>& boxes, std::string& sql, std::vector<column_def>& keys, std::vector<column_def>& params)
 {
   using namespace std;
 
@@ -211,21 +215,22 @@ inline void dialect_sqlite::sql_intersect(command*, const table_def& tbl, const
   for (auto box(begin(boxes)); box != end(boxes); ++box)
   {
     if (box != begin(boxes)) sql += " OR ";
-    const double xmin(box->min_corner().get<0>()), ymin(box->min_corner().get<1>()), xmax(box->max_corner().get<0>()), ymax(box->max_corner().get<1>());
-    ostringstream stream; stream.imbue(locale::classic()); stream << scientific; stream.precision(17);
-    stream << "(xmax >= " << xmin << " AND xmin <= " << xmax << " AND ymax >= " << ymin << " AND ymin <= " << ymax << ")";
-    sql += stream.str();
+    const vector<string> coords(sql_box(cmd, *box, params));
+    sql += "(xmax >= " + coords[0] + " AND ymax >= " + coords[1] + " AND xmin <= " + coords[2] + " AND ymin <= " + coords[3] + ")"; // in order of parameters
   }
 }
 
-inline std::string dialect_sqlite::sql_intersect(const table_def& tbl, const std::string& col, const boost::box& box)
+inline std::string dialect_sqlite::sql_intersect(const table_def& tbl, const std::string& col, const std::vector<std::string>& box)
 {
-  using namespace std;
+  return "MbrIntersects(" + sql_identifier(col) + ", BuildMbr(" + box[0] + ", " + box[1] + ", " + box[2] + ", " + box[3] + ", " + string_cast<char>(tbl[col]->srid) + ")) = 1"; // no index
+}
 
-  const double xmin(box.min_corner().get<0>()), ymin(box.min_corner().get<1>()), xmax(box.max_corner().get<0>()), ymax(box.max_corner().get<1>());
-  ostringstream stream; stream.imbue(locale::classic()); stream << scientific; stream.precision(17);
-  stream << "MbrIntersects(" << sql_identifier(col) << ", BuildMbr(" << xmin << ", " << ymin << ", " << xmax << ", " << ymax << ", " << tbl[col]->srid << ")) = 1"; // no index
-  return stream.str();
+inline std::string dialect_sqlite::sql_partition(int64_t lower, int64_t upper)
+{
+  std::string sql;
+  if (lower != std::numeric_limits<int64_t>::min()) sql += "rowid >= " + string_cast<char>(lower);
+  if (upper != std::numeric_limits<int64_t>::max()) sql += std::string(sql.empty()? "": " AND ") + "rowid < " + string_cast<char>(upper);
+  return sql.empty()? "1 = 1": sql;
 } // dialect_sqlite::
 
 } } } // brig::database::detail
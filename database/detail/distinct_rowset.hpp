@@ -0,0 +1,59 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_DISTINCT_ROWSET_HPP
+#define BRIG_DATABASE_DETAIL_DISTINCT_ROWSET_HPP
+
+#include <brig/database/detail/flight_key.hpp>
+#include <brig/detail/batch_visitor.hpp>
+#include <brig/rowset.hpp>
+#include <brig/variant.hpp>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace brig { namespace database { namespace detail {
+
+/*!
+the first row of every key, the columns from width on (keys added for the filter) are dropped,
+rows < 0 - unlimited
+*/
+class distinct_rowset : public rowset {
+  std::shared_ptr<rowset> m_rs;
+  std::vector<size_t> m_keys;
+  size_t m_width;
+  int m_rows;
+  std::unordered_set<std::string> m_seen;
+
+public:
+  distinct_rowset(std::shared_ptr<rowset> rs, const std::vector<size_t>& keys, size_t width, int rows = -1) : m_rs(rs), m_keys(keys), m_width(width), m_rows(rows)  {}
+  std::vector<std::string> columns() override;
+  bool fetch(std::vector<variant>& row) override;
+  void cancel() override  { m_rs->cancel(); }
+}; // distinct_rowset
+
+inline std::vector<std::string> distinct_rowset::columns()
+{
+  std::vector<std::string> cols(m_rs->columns());
+  if (cols.size() > m_width) cols.resize(m_width);
+  return cols;
+}
+
+inline bool distinct_rowset::fetch(std::vector<variant>& row)
+{
+  while (m_rows != 0 && m_rs->fetch(row))
+  {
+    std::string key;
+    flight_key_writer writer(key);
+    for (size_t i: m_keys) ::boost::apply_visitor(brig::detail::batch_visitor<flight_key_writer>(writer), row[i]);
+    if (!m_seen.insert(key).second) continue;
+    if (row.size() > m_width) row.resize(m_width);
+    if (m_rows > 0) --m_rows;
+    return true;
+  }
+  return false;
+} // distinct_rowset::
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_DISTINCT_ROWSET_HPP
@@ -0,0 +1,73 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_FETCH_SIZER_HPP
+#define BRIG_DATABASE_DETAIL_FETCH_SIZER_HPP
+
+#include <algorithm>
+#include <brig/database/fetch_stats.hpp>
+#include <brig/global.hpp>
+
+namespace brig { namespace database { namespace detail {
+
+/*!
+adaptive count of rows per round trip:\n
+* the size is doubled while full round trips improve rows/sec by FetchGain, then it is held (or reverted)\n
+* the size is limited by FetchBytes of the measured bytes per row\n
+* the learned size outlives statements, so it follows the latency of the connection\n
+*/
+class fetch_sizer {
+  fetch_stats m_stats;
+  size_t m_prev;
+  double m_rate, m_bytes_per_row;
+  bool m_grow;
+
+  void limit();
+
+public:
+  fetch_sizer() : m_prev(PageSize), m_rate(0), m_bytes_per_row(0), m_grow(true)  { m_stats.fetch_size = PageSize; }
+  size_t size() const  { return m_stats.fetch_size; }
+  const fetch_stats& stats() const  { return m_stats; }
+  void start()  { m_rate = 0; m_bytes_per_row = 0; m_grow = true; } // new statement
+  void measure(size_t size, size_t rows, size_t bytes, double seconds); // of the round trip with the requested size
+}; // fetch_sizer
+
+inline void fetch_sizer::limit()
+{
+  size_t size(m_stats.fetch_size);
+  if (m_bytes_per_row > 0) size = std::min<>(size, size_t(FetchBytes / m_bytes_per_row));
+  m_stats.fetch_size = std::max<>(FetchSizeMin, std::min<>(FetchSizeMax, size));
+}
+
+inline void fetch_sizer::measure(size_t size, size_t rows, size_t bytes, double seconds)
+{
+  ++m_stats.round_trips;
+  m_stats.rows += rows;
+  m_stats.bytes += bytes;
+  m_stats.seconds += seconds;
+  if (rows == 0) return;
+  m_bytes_per_row = m_bytes_per_row > 0? (m_bytes_per_row + double(bytes) / rows) / 2: double(bytes) / rows;
+
+  if (rows >= size && seconds > 0) // the last (partial) round trip says nothing about the throughput
+  {
+    const double rate(rows / seconds);
+    if (m_rate == 0 || rate > m_rate * FetchGain)
+    {
+      m_rate = rate;
+      if (m_grow)
+      {
+        m_prev = size;
+        m_stats.fetch_size = size * 2;
+      }
+    }
+    else if (m_grow)
+    {
+      m_grow = false;
+      m_stats.fetch_size = m_prev;
+    }
+  }
+  limit();
+} // fetch_sizer::
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_FETCH_SIZER_HPP
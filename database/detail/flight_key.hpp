@@ -0,0 +1,62 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_FLIGHT_KEY_HPP
+#define BRIG_DATABASE_DETAIL_FLIGHT_KEY_HPP
+
+#include <brig/column_type.hpp>
+#include <brig/detail/batch_visitor.hpp>
+#include <brig/identifier.hpp>
+#include <brig/table_def.hpp>
+#include <cstdint>
+#include <string>
+
+namespace brig { namespace database { namespace detail {
+
+class flight_key_writer {
+  std::string& m_key;
+  template <typename T>
+  void append(const T& val)  { m_key.append((const char*)&val, sizeof(val)); }
+
+public:
+  explicit flight_key_writer(std::string& key) : m_key(key)  {}
+  void push_null()  { m_key += 'n'; }
+  void push(int64_t val)  { m_key += 'i'; append(val); }
+  void push(double val)  { m_key += 'd'; append(val); }
+  void push(column_type type, const void* data, size_t size)  { m_key += char('b' + int(type)); append(size); m_key.append((const char*)data, size); }
+  void push(const std::string& str)  { push(column_type::String, str.data(), str.size()); }
+  void push(const identifier& id)  { push(id.schema); push(id.name); push(id.qualifier); }
+}; // flight_key_writer
+
+/** @return key of the request, equal for table definitions which produce the same SQL and parameters */
+inline std::string flight_key(const table_def& tbl)
+{
+  std::string key;
+  flight_key_writer writer(key);
+  writer.push(tbl.id);
+  writer.push(int64_t(tbl.query_rows));
+  for (const auto& col: tbl.query_columns) writer.push(col);
+  writer.push_null();
+  for (const auto& col: tbl.columns)
+  {
+    writer.push(col.name);
+    writer.push(int64_t(col.type));
+    writer.push(col.type_lcase);
+    writer.push(int64_t(col.chars));
+    writer.push(int64_t(col.srid));
+    writer.push(int64_t(col.epsg));
+    writer.push(col.query_expression);
+    ::boost::apply_visitor(brig::detail::batch_visitor<flight_key_writer>(writer), col.query_value);
+  }
+  for (const auto& idx: tbl.indexes)
+  {
+    writer.push(idx.id);
+    writer.push(int64_t(idx.type));
+    for (const auto& col: idx.columns) writer.push(col);
+    writer.push_null();
+  }
+  return key;
+}
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_FLIGHT_KEY_HPP
@@ -0,0 +1,42 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_GET_PARTITIONS_HPP
+#define BRIG_DATABASE_DETAIL_GET_PARTITIONS_HPP
+
+#include <algorithm>
+#include <brig/database/command.hpp>
+#include <brig/database/detail/dialect.hpp>
+#include <brig/numeric_cast.hpp>
+#include <brig/table_def.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace brig { namespace database { namespace detail {
+
+/** @return conditions of disjoint ranges which cover the table, empty if it can not be partitioned */
+inline std::vector<std::string> get_partitions(dialect* dct, command* cmd, const table_def& tbl, size_t count)
+{
+  using namespace std;
+
+  vector<string> res;
+  const string sql(dct->sql_partition_bounds(tbl));
+  if (sql.empty() || count < 2) return res;
+  cmd->exec(sql);
+  vector<variant> row;
+  int64_t lower(0), upper(0);
+  if (!cmd->fetch(row) || !numeric_cast(row[0], lower) || !numeric_cast(row[1], upper) || upper <= lower) return res;
+  count = size_t(min<>(uint64_t(count), uint64_t(upper - lower)));
+  const int64_t step((upper - lower) / int64_t(count) + 1);
+  for (size_t i(0); i < count; ++i)
+    res.push_back(dct->sql_partition
+      ( i == 0? numeric_limits<int64_t>::min(): lower + int64_t(i) * step
+      , i + 1 == count? numeric_limits<int64_t>::max(): lower + int64_t(i + 1) * step
+      ));
+  return res;
+}
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_GET_PARTITIONS_HPP
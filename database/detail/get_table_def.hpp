@@ -13,15 +13,79 @@
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
 #include <iterator>
+#include <map>
 #include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace brig { namespace database { namespace detail {
 
-inline table_def get_table_def(dialect* dct, command* cmd, const identifier& tbl)
+/** @return column from the row of dialect::sql_columns() starting at offset */
+inline column_def get_column_def(dialect* dct, const std::vector<variant>& row, size_t offset)
+{
+  using namespace brig::unicode;
+
+  column_def col;
+  col.name = string_cast<char>(row[offset]);
+  col.type_lcase.schema = transform<char>(string_cast<char>(row[offset + 1]), lower_case);
+  col.type_lcase.name = transform<char>(string_cast<char>(row[offset + 2]), lower_case);
+  numeric_cast(row[offset + 3], col.chars);
+  int scale(-1);
+  numeric_cast(row[offset + 4], scale);
+  col.type = dct->get_type(col.type_lcase, scale);
+  int not_null(0);
+  col.not_null = (numeric_cast(row[offset + 5], not_null) && not_null);
+  return col;
+}
+
+/** accumulates rows of dialect::sql_indexed_columns() starting at offset, idx is flushed when index changes */
+inline void add_indexed_column(table_def& tbl, index_def& idx, const std::vector<variant>& row, size_t offset)
 {
   using namespace std;
+
+  identifier id = { string_cast<char>(row[offset]), string_cast<char>(row[offset + 1]), "" };
+
+  if (id.schema != idx.id.schema || id.name != idx.id.name)
+  {
+    if (index_type::Void != idx.type) tbl.indexes.push_back(move(idx));
+
+    idx = index_def();
+    idx.id = id;
+    int primary(0), unique(0), spatial(0);
+    numeric_cast(row[offset + 2], primary);
+    numeric_cast(row[offset + 3], unique);
+    numeric_cast(row[offset + 4], spatial);
+    if (primary) idx.type = index_type::Primary;
+    else if (unique) idx.type = index_type::Unique;
+    else if (spatial) idx.type = index_type::Spatial;
+    else idx.type = index_type::Duplicate;
+  }
+
+  const string col_name(string_cast<char>(row[offset + 5]));
+  idx.columns.push_back(col_name);
+  if (!find_column(begin(tbl.columns), end(tbl.columns), col_name)) idx.type = index_type::Void; // expression
+
+  int desc(0);
+  if (numeric_cast(row[offset + 6], desc) && desc) idx.type = index_type::Void; // descending
+}
+
+/** srid, epsg, type qualifier from the row of dialect::sql_spatial_detail() starting at offset */
+inline void set_spatial_detail(column_def& col, const std::vector<variant>& row, size_t offset)
+{
   using namespace brig::unicode;
 
+  numeric_cast(row[offset], col.srid);
+  if (row.size() > offset + 1) numeric_cast(row[offset + 1], col.epsg);
+  else col.epsg = col.srid;
+  if (row.size() > offset + 2 && typeid(null_t) != row[offset + 2].type()) col.type_lcase.qualifier = transform<char>(string_cast<char>(row[offset + 2]), lower_case);
+}
+
+inline table_def get_table_def(dialect* dct, command* cmd, const identifier& tbl)
+{
+  using namespace std;
+
   if (cmd->system() == DBMS::SQLite) return get_table_def_sqlite(dct, cmd, tbl);
 
   // columns
@@ -29,52 +93,13 @@ inline table_def get_table_def(dialect* dct, command* cmd, const identifier& tbl
   res.id = tbl;
   cmd->exec(dct->sql_columns(res.id));
   vector<variant> row;
-  while (cmd->fetch(row))
-  {
-    column_def col;
-    col.name = string_cast<char>(row[0]);
-    col.type_lcase.schema = transform<char>(string_cast<char>(row[1]), lower_case);
-    col.type_lcase.name = transform<char>(string_cast<char>(row[2]), lower_case);
-    numeric_cast(row[3], col.chars);
-    int scale(-1);
-    numeric_cast(row[4], scale);
-    col.type = dct->get_type(col.type_lcase, scale);
-    int not_null(0);
-    col.not_null = (numeric_cast(row[5], not_null) && not_null);
-    res.columns.push_back(col);
-  }
+  while (cmd->fetch(row)) res.columns.push_back(get_column_def(dct, row, 0));
   if (res.columns.empty()) throw runtime_error("table error");
 
   // indexes
   cmd->exec(dct->sql_indexed_columns(res.id));
   index_def idx;
-  while (cmd->fetch(row))
-  {
-    identifier id = { string_cast<char>(row[0]), string_cast<char>(row[1]), "" };
-
-    if (id.schema != idx.id.schema || id.name != idx.id.name)
-    {
-      if (index_type::Void != idx.type) res.indexes.push_back(move(idx));
-
-      idx = index_def();
-      idx.id = id;
-      int primary(0), unique(0), spatial(0);
-      numeric_cast(row[2], primary);
-      numeric_cast(row[3], unique);
-      numeric_cast(row[4], spatial);
-      if (primary) idx.type = index_type::Primary;
-      else if (unique) idx.type = index_type::Unique;
-      else if (spatial) idx.type = index_type::Spatial;
-      else idx.type = index_type::Duplicate;
-    }
-
-    const string col_name(string_cast<char>(row[5]));
-    idx.columns.push_back(col_name);
-    if (!find_column(begin(res.columns), end(res.columns), col_name)) idx.type = index_type::Void; // expression
-
-    int desc(0);
-    if (numeric_cast(row[6], desc) && desc) idx.type = index_type::Void; // descending
-  }
+  while (cmd->fetch(row)) add_indexed_column(res, idx, row, 0);
   if (index_type::Void != idx.type) res.indexes.push_back(move(idx));
 
   // srid, epsg, type qualifier
@@ -83,17 +108,87 @@ inline table_def get_table_def(dialect* dct, command* cmd, const identifier& tbl
     {
       const string sql(dct->sql_spatial_detail(res, col.name));
       cmd->exec(sql);
-      if (cmd->fetch(row))
-      {
-        numeric_cast(row[0], col.srid);
-        if (row.size() > 1) numeric_cast(row[1], col.epsg);
-        else col.epsg = col.srid;
-        if (row.size() > 2) col.type_lcase.qualifier = transform<char>(string_cast<char>(row[2]), lower_case);
-      }
+      if (cmd->fetch(row)) set_spatial_detail(col, row, 0);
     }
   return res;
 }
 
+/*!
+set-based variant: columns, indexed columns and spatial details of all tables are fetched by three queries,
+dialects without set-based catalog SQL are described table by table
+*/
+inline std::vector<table_def> get_table_defs(dialect* dct, command* cmd, const std::vector<identifier>& tbls)
+{
+  using namespace std;
+
+  if (cmd->system() == DBMS::SQLite) return get_table_defs_sqlite(dct, cmd, tbls);
+
+  vector<table_def> res;
+  const string sql_columns(tbls.size() > 1? dct->sql_columns_bulk(tbls): string());
+  if (sql_columns.empty())
+  {
+    for (const auto& tbl: tbls) res.push_back(get_table_def(dct, cmd, tbl));
+    return res;
+  }
+
+  map<pair<string, string>, size_t> positions;
+  for (const auto& tbl: tbls)
+  {
+    positions[make_pair(tbl.schema, tbl.name)] = res.size();
+    res.push_back(table_def());
+    res.back().id = tbl;
+  }
+  vector<variant> row;
+  auto find_table([&](const vector<variant>& row) -> table_def*
+  {
+    auto iter(positions.find(make_pair(string_cast<char>(row[0]), string_cast<char>(row[1]))));
+    return iter == positions.end()? 0: &res[iter->second];
+  });
+
+  // columns
+  cmd->exec(sql_columns);
+  while (cmd->fetch(row))
+  {
+    table_def* tbl(find_table(row));
+    if (tbl) tbl->columns.push_back(get_column_def(dct, row, 2));
+  }
+  for (const auto& tbl: res)
+    if (tbl.columns.empty()) throw runtime_error("table error");
+
+  // indexes
+  vector<index_def> idxs(res.size());
+  cmd->exec(dct->sql_indexed_columns_bulk(tbls));
+  while (cmd->fetch(row))
+  {
+    table_def* tbl(find_table(row));
+    if (tbl) add_indexed_column(*tbl, idxs[tbl - res.data()], row, 2);
+  }
+  for (size_t i(0); i < res.size(); ++i)
+    if (index_type::Void != idxs[i].type) res[i].indexes.push_back(move(idxs[i]));
+
+  // srid, epsg, type qualifier
+  const string sql_spatial_details(dct->sql_spatial_details_bulk(res));
+  if (sql_spatial_details.empty())
+  {
+    for (auto& tbl: res)
+      for (auto& col: tbl.columns)
+        if (column_type::Geometry == col.type)
+        {
+          cmd->exec(dct->sql_spatial_detail(tbl, col.name));
+          if (cmd->fetch(row)) set_spatial_detail(col, row, 0);
+        }
+    return res;
+  }
+  cmd->exec(sql_spatial_details);
+  while (cmd->fetch(row))
+  {
+    table_def* tbl(find_table(row));
+    column_def* col(tbl? (*tbl)[string_cast<char>(row[2])]: 0);
+    if (col && column_type::Geometry == col->type) set_spatial_detail(*col, row, 3);
+  }
+  return res;
+}
+
 } } } // brig::database::detail
 
 #endif // BRIG_DATABASE_DETAIL_GET_TABLE_DEF_HPP
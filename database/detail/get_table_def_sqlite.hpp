@@ -15,10 +15,52 @@
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
 #include <iterator>
+#include <map>
 #include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace brig { namespace database { namespace detail {
 
+/** adds the column from the row of PRAGMA TABLE_INFO starting at offset */
+inline void add_column_sqlite(table_def& tbl, index_def& pri_idx, const std::vector<variant>& row, size_t offset)
+{
+  column_def col;
+  col.name = string_cast<char>(row[offset + 1]);
+  col.type_lcase.name = brig::unicode::transform<char>(string_cast<char>(row[offset + 2]), brig::unicode::lower_case);
+
+  if (is_ogc_type(col.type_lcase.name)) col.type = column_type::Geometry;
+  else col.type = get_iso_type(col.type_lcase.name, -1);
+
+  int not_null(0);
+  col.not_null = (numeric_cast(row[offset + 3], not_null) && not_null);
+  tbl.columns.push_back(col);
+
+  int key(0);
+  if (numeric_cast(row[offset + 5], key) && key > 0) // one-based
+  {
+    if (pri_idx.columns.size() < size_t(key)) pri_idx.columns.resize(key);
+    pri_idx.columns[key - 1] = col.name;
+  }
+}
+
+/** srid, epsg, spatial index from the row of GEOMETRY_COLUMNS starting at offset */
+inline void set_spatial_detail_sqlite(table_def& tbl, column_def& col, const std::vector<variant>& row, size_t offset)
+{
+  numeric_cast(row[offset], col.srid);
+  numeric_cast(row[offset + 1], col.epsg);
+  int indexed(0);
+  if (numeric_cast(row[offset + 2], indexed) && indexed == 1)
+  {
+    index_def idx;
+    idx.type = index_type::Spatial;
+    idx.columns.push_back(col.name);
+    tbl.indexes.push_back(idx);
+  }
+}
+
 inline table_def get_table_def_sqlite(dialect* dct, command* cmd, const identifier& tbl)
 {
   using namespace std;
@@ -30,26 +72,7 @@ inline table_def get_table_def_sqlite(dialect* dct, command* cmd, const identifi
   pri_idx.type = index_type::Primary;
   vector<variant> row;
   cmd->exec("PRAGMA TABLE_INFO(" + dct->sql_identifier(tbl.name) + ")");
-  while (cmd->fetch(row))
-  {
-    column_def col;
-    col.name = string_cast<char>(row[1]);
-    col.type_lcase.name = brig::unicode::transform<char>(string_cast<char>(row[2]), brig::unicode::lower_case);
-
-    if (is_ogc_type(col.type_lcase.name)) col.type = column_type::Geometry;
-    else col.type = get_iso_type(col.type_lcase.name, -1);
-
-    int not_null(0);
-    col.not_null = (numeric_cast(row[3], not_null) && not_null);
-    res.columns.push_back(col);
-
-    int key(0);
-    if (numeric_cast(row[5], key) && key > 0) // one-based
-    {
-      if (pri_idx.columns.size() < size_t(key)) pri_idx.columns.resize(key);
-      pri_idx.columns[key - 1] = col.name;
-    }
-  }
+  while (cmd->fetch(row)) add_column_sqlite(res, pri_idx, row, 0);
   if (res.columns.empty()) throw runtime_error("table error");
   if (!pri_idx.columns.empty()) res.indexes.push_back(pri_idx);
 
@@ -92,21 +115,112 @@ inline table_def get_table_def_sqlite(dialect* dct, command* cmd, const identifi
 SELECT c.SRID, (CASE s.AUTH_NAME WHEN 'epsg' THEN s.AUTH_SRID ELSE NULL END) epsg, c.SPATIAL_INDEX_ENABLED \
 FROM (SELECT SRID, SPATIAL_INDEX_ENABLED FROM GEOMETRY_COLUMNS WHERE F_TABLE_NAME = '" + tbl.name + "' AND F_GEOMETRY_COLUMN = '" + res.columns[i].name + "') c \
 LEFT JOIN SPATIAL_REF_SYS s ON c.SRID = s.SRID");
-      if (cmd->fetch(row))
+      if (cmd->fetch(row)) set_spatial_detail_sqlite(res, res.columns[i], row, 0);
+    }
+  }
+  return res;
+}
+
+/*!
+set-based variant with table-valued pragma functions (SQLite 3.16+), older libraries are described table by table
+*/
+inline std::vector<table_def> get_table_defs_sqlite(dialect* dct, command* cmd, const std::vector<identifier>& tbls)
+{
+  using namespace std;
+
+  vector<table_def> res;
+  if (tbls.size() < 2)
+  {
+    for (const auto& tbl: tbls) res.push_back(get_table_def_sqlite(dct, cmd, tbl));
+    return res;
+  }
+
+  map<string, size_t> positions;
+  string names;
+  for (const auto& tbl: tbls)
+  {
+    positions[tbl.name] = res.size();
+    res.push_back(table_def());
+    res.back().id = tbl;
+    names += (names.empty()? "'": ", '") + tbl.name + "'";
+  }
+  vector<variant> row;
+
+  // columns
+  vector<index_def> pri_idxs(res.size());
+  try
+  {
+    cmd->exec("SELECT m.name, p.* FROM sqlite_master m, pragma_table_info(m.name) p WHERE m.name IN (" + names + ") ORDER BY m.name, p.cid");
+  }
+  catch (const exception&)
+  {
+    res.clear();
+    for (const auto& tbl: tbls) res.push_back(get_table_def_sqlite(dct, cmd, tbl));
+    return res;
+  }
+  while (cmd->fetch(row))
+  {
+    auto iter(positions.find(string_cast<char>(row[0])));
+    if (iter != positions.end()) add_column_sqlite(res[iter->second], pri_idxs[iter->second], row, 1);
+  }
+  for (size_t i(0); i < res.size(); ++i)
+  {
+    if (res[i].columns.empty()) throw runtime_error("table error");
+    pri_idxs[i].type = index_type::Primary;
+    if (!pri_idxs[i].columns.empty()) res[i].indexes.push_back(pri_idxs[i]);
+  }
+
+  // indexes, indexed columns
+  cmd->exec("\
+SELECT m.name, l.name, l.\"unique\", i.seqno, i.name \
+FROM sqlite_master m, pragma_index_list(m.name) l LEFT JOIN pragma_index_info(l.name) i \
+WHERE m.name IN (" + names + ") ORDER BY m.name, l.seq, i.seqno");
+  vector<string> idx_names(res.size());
+  while (cmd->fetch(row))
+  {
+    auto iter(positions.find(string_cast<char>(row[0])));
+    const string idx_name(string_cast<char>(row[1]));
+    if (iter == positions.end() || idx_name.empty()) continue;
+    table_def& tbl(res[iter->second]);
+    if (idx_names[iter->second] != idx_name)
+    {
+      idx_names[iter->second] = idx_name;
+      index_def idx;
+      idx.id.name = idx_name;
+      int unique(0);
+      idx.type = (numeric_cast(row[2], unique) && !unique)? index_type::Duplicate: index_type::Unique;
+      tbl.indexes.push_back(idx);
+    }
+    if (typeid(null_t) != row[3].type()) tbl.indexes.back().columns.push_back(string_cast<char>(row[4]));
+  }
+
+  // srid, epsg, spatial index
+  string geometry_names;
+  for (const auto& tbl: res)
+    for (const auto& col: tbl.columns)
+      if (column_type::Geometry == col.type)
       {
-        numeric_cast(row[0], res.columns[i].srid);
-        numeric_cast(row[1], res.columns[i].epsg);
-        int indexed(0);
-        if (numeric_cast(row[2], indexed) && indexed == 1)
-        {
-          index_def idx;
-          idx.type = index_type::Spatial;
-          idx.columns.push_back(res.columns[i].name);
-          res.indexes.push_back(idx);
-        }
+        geometry_names += (geometry_names.empty()? "'": ", '") + tbl.id.name + "'";
+        break;
       }
-    }
+  if (geometry_names.empty()) return res;
+  cmd->exec("\
+SELECT c.F_TABLE_NAME, c.F_GEOMETRY_COLUMN, c.SRID, (CASE s.AUTH_NAME WHEN 'epsg' THEN s.AUTH_SRID ELSE NULL END) epsg, c.SPATIAL_INDEX_ENABLED \
+FROM GEOMETRY_COLUMNS c LEFT JOIN SPATIAL_REF_SYS s ON c.SRID = s.SRID \
+WHERE c.F_TABLE_NAME IN (" + geometry_names + ")");
+  map<pair<string, string>, vector<variant>> details;
+  while (cmd->fetch(row))
+  {
+    const pair<string, string> key(string_cast<char>(row[0]), string_cast<char>(row[1]));
+    if (details.find(key) == details.end()) details[key] = row;
   }
+  for (auto& tbl: res)
+    for (auto& col: tbl.columns)
+      if (column_type::Geometry == col.type)
+      {
+        auto iter(details.find(make_pair(tbl.id.name, col.name)));
+        if (iter != details.end()) set_spatial_detail_sqlite(tbl, col, iter->second, 2);
+      }
   return res;
 }
 
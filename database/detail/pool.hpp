@@ -6,67 +6,192 @@
 #include <boost/utility.hpp>
 #include <brig/database/command.hpp>
 #include <brig/database/command_allocator.hpp>
-#include <brig/database/detail/threaded_command_allocator.hpp>
-#include <brig/global.hpp>
+#include <brig/database/pool_options.hpp>
+#include <brig/database/pool_stats.hpp>
+#include <brig/executor.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <memory>
 #include <mutex>
-#include <stack>
+#include <thread>
+#include <vector>
 
 namespace brig { namespace database { namespace detail {
 
-template <bool Threading> class pool;
+class pool : public std::enable_shared_from_this<pool>, ::boost::noncopyable {
+  typedef std::chrono::steady_clock clock;
+  struct idle_command {
+    command* cmd;
+    std::thread::id thread;
+    clock::time_point released;
+  }; // idle_command
 
-template <> class pool<false> : ::boost::noncopyable {
   std::shared_ptr<command_allocator> m_allocator;
-  std::stack<command*> m_commands;
+  const pool_options m_options;
+  std::mutex m_mut;
+  std::condition_variable m_cv;
+  std::deque<idle_command> m_idle; // oldest first
+  size_t m_busy; // including commands being opened
+  pool_stats m_stats;
+
+  bool full() const  { return m_options.max_size > 0 && m_busy + m_idle.size() >= m_options.max_size; }
+  void evict(std::vector<command*>& cmds);
+  command* create();
+  void prepare();
+
 public:
-  explicit pool(std::shared_ptr<command_allocator> allocator) : m_allocator(allocator)  {}
+  pool(std::shared_ptr<command_allocator> allocator, const pool_options& options) : m_allocator(allocator), m_options(options), m_busy(0)  {}
   virtual ~pool();
   command* allocate();
   void deallocate(command* cmd);
-}; // pool<false>
+  void warmup(); // opens min_size commands in background, errors are ignored
+  pool_stats stats();
+}; // pool
+
+inline pool::~pool()
+{
+  for (const auto& entry: m_idle) delete entry.cmd;
+}
 
-inline pool<false>::~pool()
+inline void pool::evict(std::vector<command*>& cmds)
 {
-  while (!m_commands.empty())
+  const auto deadline(clock::now() - std::chrono::seconds(m_options.idle_sec));
+  while (m_idle.size() > m_options.min_size && m_idle.front().released < deadline)
   {
-    delete m_commands.top();
-    m_commands.pop();
+    cmds.push_back(m_idle.front().cmd);
+    m_idle.pop_front();
+    ++m_stats.evictions;
   }
 }
 
-inline command* pool<false>::allocate()
+inline command* pool::create()
 {
-  if (m_commands.empty()) return m_allocator->allocate();
-  command* cmd(m_commands.top());
-  m_commands.pop();
+  using namespace std;
+  using namespace std::chrono;
+
+  const auto start(clock::now());
+  command* cmd(0);
+  try
+  {
+    cmd = m_allocator->allocate();
+  }
+  catch (const exception&)
+  {
+    lock_guard<mutex> lck(m_mut);
+    --m_busy;
+    m_cv.notify_one();
+    throw;
+  }
+  const double seconds(duration_cast<duration<double>>(clock::now() - start).count());
+  lock_guard<mutex> lck(m_mut);
+  ++m_stats.creations;
+  m_stats.create_seconds += seconds;
   return cmd;
 }
 
-inline void pool<false>::deallocate(command* cmd)
+inline command* pool::allocate()
 {
-  if (m_commands.size() < PoolSize)
+  using namespace std;
+  using namespace std::chrono;
+
+  vector<command*> evicted;
+  command* cmd(0);
   {
-    try
+    unique_lock<mutex> lck(m_mut);
+    evict(evicted);
+    if (m_idle.empty() && full())
+    {
+      const auto start(clock::now());
+      m_cv.wait(lck, [&]()  { return !m_idle.empty() || !full(); });
+      ++m_stats.waits;
+      m_stats.wait_seconds += duration_cast<duration<double>>(clock::now() - start).count();
+    }
+    ++m_busy;
+    if (!m_idle.empty())
     {
-      cmd->set_autocommit(false);
-      cmd->set_autocommit(true);
-      m_commands.push(cmd);
-      return;
+      auto iter(m_idle.end() - 1);
+      if (m_options.affinity)
+        for (auto r_iter(m_idle.rbegin()); r_iter != m_idle.rend(); ++r_iter)
+          if (r_iter->thread == this_thread::get_id())  { iter = r_iter.base() - 1; break; }
+      cmd = iter->cmd;
+      m_idle.erase(iter);
+      ++m_stats.hits;
     }
-    catch (const std::exception&)  {}
+  }
+  for (auto evicted_cmd: evicted) delete evicted_cmd;
+  return cmd? cmd: create();
+}
+
+inline void pool::deallocate(command* cmd)
+{
+  using namespace std;
+
+  bool keep(false);
+  {
+    lock_guard<mutex> lck(m_mut);
+    keep = m_idle.size() < m_options.max_idle;
+  }
+  if (keep)
+  {
+    try  { cmd->reset(); }
+    catch (const exception&)  { keep = false; }
+  }
+  {
+    lock_guard<mutex> lck(m_mut);
+    --m_busy;
+    if (keep && m_idle.size() < m_options.max_idle)
+    {
+      idle_command entry = {cmd, this_thread::get_id(), clock::now()};
+      m_idle.push_back(entry);
+      cmd = 0;
+    }
+    m_cv.notify_one();
   }
   delete cmd;
-} // pool<false>::
+}
 
-template <> class pool<true> : public pool<false> {
-  std::mutex m_mut;
-public:
-  explicit pool(std::shared_ptr<command_allocator> allocator) : pool<false>(std::make_shared<threaded_command_allocator>(allocator))  {}
-  command* allocate()  { std::lock_guard<typename std::mutex> lck(m_mut); return pool<false>::allocate(); }
-  void deallocate(command* cmd)  { std::lock_guard<typename std::mutex> lck(m_mut); pool<false>::deallocate(cmd); }
-}; // pool<true>
+inline void pool::prepare()
+{
+  using namespace std;
+
+  {
+    lock_guard<mutex> lck(m_mut);
+    if (m_busy + m_idle.size() >= m_options.min_size || full()) return;
+    ++m_busy;
+  }
+  command* cmd(create());
+  lock_guard<mutex> lck(m_mut);
+  --m_busy;
+  idle_command entry = {cmd, thread::id(), clock::now()};
+  m_idle.push_back(entry); // released now, so the order stays oldest first
+  m_cv.notify_one();
+}
+
+inline void pool::warmup()
+{
+  using namespace std;
+
+  const weak_ptr<pool> weak(shared_from_this());
+  for (size_t i(0); i < m_options.min_size; ++i)
+    executor::singleton().submit([weak]()
+    {
+      auto self(weak.lock());
+      if (!self) return;
+      try  { self->prepare(); }
+      catch (const exception&)  {}
+    });
+}
+
+inline pool_stats pool::stats()
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  pool_stats res(m_stats);
+  res.idle = m_idle.size();
+  res.busy = m_busy;
+  return res;
+} // pool::
 
 } } } // brig::database::detail
 
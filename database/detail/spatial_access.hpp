@@ -0,0 +1,47 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_SPATIAL_ACCESS_HPP
+#define BRIG_DATABASE_DETAIL_SPATIAL_ACCESS_HPP
+
+#include <algorithm>
+#include <boost/geometry/geometry.hpp>
+#include <brig/boost/geometry.hpp>
+#include <brig/global.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace brig { namespace database { namespace detail {
+
+enum class spatial_access {
+  Index, // keys of dialect::sql_intersect(cmd, ...) joined with the table if the dialect has them, otherwise predicates
+  Predicate // dialect::sql_intersect(tbl, col, box) predicates on the table
+}; // spatial_access
+
+/*!
+cost model of a spatial select:\n
+* selectivity is the share of the layer extent covered by the query boxes (see boost::cover())\n
+* a row through the index join costs IndexJoinCost scanned rows, tables under IndexRowsMin rows are scanned\n
+* rows < 0 - unknown\n
+* the extent may be stale, so the box predicate is never dropped\n
+*/
+inline spatial_access choose_spatial_access(const std::vector<boost::box>& boxes, const boost::box& extent, int64_t rows)
+{
+  using namespace std;
+  if (any_of(begin(boxes), end(boxes), [&](const boost::box& box){ return ::boost::geometry::covered_by(extent, box); })) return spatial_access::Predicate;
+  const double extent_area(::boost::geometry::area(extent));
+  if (!(extent_area > 0)) return spatial_access::Index;
+  double common_area(0);
+  for (const auto& box: boxes)
+  {
+    boost::box common;
+    if (::boost::geometry::intersection(box, extent, common)) common_area += ::boost::geometry::area(common);
+  }
+  if (!(common_area > 0)) return spatial_access::Index;
+  if (rows >= 0 && uint64_t(rows) < IndexRowsMin) return spatial_access::Predicate;
+  const double selectivity(common_area / extent_area); // boxes of the cover do not overlap
+  return selectivity * IndexJoinCost < 1? spatial_access::Index: spatial_access::Predicate;
+}
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_SPATIAL_ACCESS_HPP
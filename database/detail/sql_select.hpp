@@ -4,12 +4,14 @@
 #define BRIG_DATABASE_DETAIL_SQL_SELECT_HPP
 
 #include <algorithm>
+#include <brig/boost/cover.hpp>
 #include <brig/boost/envelope.hpp>
 #include <brig/boost/geom_from_wkb.hpp>
 #include <brig/boost/geometry.hpp>
 #include <brig/database/command.hpp>
 #include <brig/database/detail/dialect.hpp>
 #include <brig/database/detail/normalize_hemisphere.hpp>
+#include <brig/database/detail/spatial_access.hpp>
 #include <brig/database/detail/sql_select_list.hpp>
 #include <brig/detail/get_columns.hpp>
 #include <brig/global.hpp>
@@ -20,7 +22,7 @@
 
 namespace brig { namespace database { namespace detail {
 
-inline void sql_select(dialect* dct, command* cmd, const table_def& tbl, std::string& sql, std::vector<column_def>& params)
+inline void sql_select(dialect* dct, command* cmd, const table_def& tbl, std::string& sql, std::vector<column_def>& params, const std::string& sql_partition = "", spatial_access access = spatial_access::Index, size_t max_boxes = 1)
 {
   using namespace std;
   using namespace brig::boost;
@@ -28,6 +30,26 @@ inline void sql_select(dialect* dct, command* cmd, const table_def& tbl, std::st
   vector<column_def> cols = tbl.query_columns.empty()? tbl.columns: brig::detail::get_columns(tbl.columns, tbl.query_columns);
   string sql_infix, sql_counter, sql_suffix, sql_conditions;
   if (tbl.query_rows >= 0) dct->sql_limit(tbl.query_rows, sql_infix, sql_counter, sql_suffix);
+
+  // parameters in order of the select text: spatial, then not spatial
+  // box coordinates are parameters for SQLite and MySQL, so their statement caches reuse the text; Postgres selects are cursors and are not prepared
+  auto geom_col(find_if(begin(tbl.columns), end(tbl.columns), [](const column_def& col){ return column_type::Geometry == col.type && typeid(null_t) != col.query_value.type(); }));
+  vector<box> boxes;
+  string sql_keys, sql_boxes;
+  vector<column_def> keys;
+  if (geom_col != end(tbl.columns))
+  {
+    boxes = cover(geom_from_wkb(::boost::get<blob_t>(geom_col->query_value)), max_boxes);
+    if (dct->need_to_normalize_hemisphere(*geom_col)) normalize_hemisphere(boxes);
+    if (spatial_access::Index == access) dct->sql_intersect(cmd, tbl, geom_col->name, boxes, sql_keys, keys, params);
+    if (sql_keys.empty())
+      for (auto box(begin(boxes)); box != end(boxes); ++box)
+      {
+        if (box != begin(boxes)) sql_boxes += " OR ";
+        sql_boxes += "(" + dct->sql_intersect(cmd, tbl, geom_col->name, *box, params) + ")";
+      }
+  }
+
   for (const auto& col: tbl.columns)
     if (column_type::Geometry != col.type && typeid(null_t) != col.query_value.type())
     {
@@ -36,9 +58,13 @@ inline void sql_select(dialect* dct, command* cmd, const table_def& tbl, std::st
       sql_conditions += " = (" + dct->sql_parameter(cmd, col, params.size()) + ")"; // Oracle workaround
       params.push_back(col);
     }
+  if (!sql_partition.empty())
+  {
+    if (!sql_conditions.empty()) sql_conditions += "AND ";
+    sql_conditions += "(" + sql_partition + ")";
+  }
 
   // not spatial first
-  auto geom_col(find_if(begin(tbl.columns), end(tbl.columns), [](const column_def& col){ return column_type::Geometry == col.type && typeid(null_t) != col.query_value.type(); }));
   if (geom_col == end(tbl.columns))
   {
     if (!sql_counter.empty()) sql += "SELECT * FROM (";
@@ -50,24 +76,13 @@ inline void sql_select(dialect* dct, command* cmd, const table_def& tbl, std::st
   }
 
   // spatial
-  vector<box> boxes(1, envelope(geom_from_wkb(::boost::get<blob_t>(geom_col->query_value))));
-  if (dct->need_to_normalize_hemisphere(*geom_col)) normalize_hemisphere(boxes);
-  string sql_keys;
-  vector<column_def> keys;
-  dct->sql_intersect(cmd, tbl, geom_col->name, boxes, sql_keys, keys);
   const string sql_tbl(dct->sql_identifier(tbl.id));
 
   if (!sql_counter.empty()) sql += "SELECT * FROM (";
   sql += "SELECT " + sql_infix + " ";
   if (sql_keys.empty())
   {
-    sql += sql_select_list(dct, cmd, cols) + " FROM " + sql_tbl + " " + dct->sql_hint(tbl, geom_col->name) + " WHERE (";
-    for (auto box(begin(boxes)); box != end(boxes); ++box)
-    {
-      if (box != begin(boxes)) sql += " OR ";
-      sql += "(" + dct->sql_intersect(tbl, geom_col->name, *box) + ")";
-    }
-    sql += ")";
+    sql += sql_select_list(dct, cmd, cols) + " FROM " + sql_tbl + " " + dct->sql_hint(tbl, geom_col->name) + " WHERE (" + sql_boxes + ")";
     if (!sql_conditions.empty()) sql += " AND " + sql_conditions;
   }
   else
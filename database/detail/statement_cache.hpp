@@ -0,0 +1,74 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_STATEMENT_CACHE_HPP
+#define BRIG_DATABASE_DETAIL_STATEMENT_CACHE_HPP
+
+#include <boost/utility.hpp>
+#include <brig/global.hpp>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace brig { namespace database { namespace detail {
+
+/*!
+LRU of prepared statements of one connection keyed by SQL text:\n
+* take() checks a statement out, put() returns it after use\n
+* the least recently used statement is closed when capacity is exceeded\n
+*/
+template <typename Statement>
+class statement_cache : ::boost::noncopyable {
+  typedef std::list<std::pair<std::string, Statement>> list_t;
+  list_t m_list; // most recently used first
+  std::map<std::string, typename list_t::iterator> m_index;
+  std::function<void(Statement&)> m_close;
+  size_t m_capacity;
+
+public:
+  explicit statement_cache(std::function<void(Statement&)> close, size_t capacity = StatementCacheSize) : m_close(close), m_capacity(capacity)  {}
+  ~statement_cache()  { clear(); }
+  bool take(const std::string& key, Statement& stmt);
+  void put(const std::string& key, Statement stmt);
+  void clear();
+}; // statement_cache
+
+template <typename Statement>
+bool statement_cache<Statement>::take(const std::string& key, Statement& stmt)
+{
+  auto iter(m_index.find(key));
+  if (iter == m_index.end()) return false;
+  stmt = iter->second->second;
+  m_list.erase(iter->second);
+  m_index.erase(iter);
+  return true;
+}
+
+template <typename Statement>
+void statement_cache<Statement>::put(const std::string& key, Statement stmt)
+{
+  if (key.empty() || m_capacity == 0 || m_index.find(key) != m_index.end())
+  {
+    m_close(stmt);
+    return;
+  }
+  m_list.push_front(std::make_pair(key, stmt));
+  m_index[key] = m_list.begin();
+  if (m_list.size() <= m_capacity) return;
+  m_index.erase(m_list.back().first);
+  m_close(m_list.back().second);
+  m_list.pop_back();
+}
+
+template <typename Statement>
+void statement_cache<Statement>::clear()
+{
+  m_index.clear();
+  for (auto& entry: m_list) m_close(entry.second);
+  m_list.clear();
+} // statement_cache::
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_STATEMENT_CACHE_HPP
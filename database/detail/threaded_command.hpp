@@ -5,57 +5,128 @@
 
 #include <brig/database/command.hpp>
 #include <brig/database/command_allocator.hpp>
-#include <brig/detail/double_page.hpp>
+#include <brig/detail/byte_budget.hpp>
 #include <brig/detail/mediator.hpp>
+#include <brig/detail/page_ring.hpp>
+#include <brig/executor.hpp>
+#include <brig/global.hpp>
 #include <exception>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace brig { namespace database { namespace detail {
 
 class threaded_command : public command {
-  struct mediator : brig::detail::mediator<command>  { brig::detail::double_page dpg; };
+  struct mediator : brig::detail::mediator<command> {
+    std::shared_ptr<command_allocator> allocator;
+    std::unique_ptr<command> cmd;
+    std::mutex cancel_mut; // cmd is allocated and released by the producer
+    brig::detail::page_ring ring;
+    mediator(std::shared_ptr<command_allocator> allocator_, size_t pages, std::shared_ptr<brig::detail::byte_budget> budget) : allocator(allocator_), ring(pages, budget, [this](){ this->wake(); })  {}
+  }; // mediator
   std::shared_ptr<mediator> m_med;
+  bool m_info; // connection constants are cached
+  DBMS m_sys;
+  bool m_readable_geom, m_writable_geom;
+  std::vector<std::string> m_params;
+
+  void get_info();
+  static void run(std::shared_ptr<mediator> med); // until idle
+  static void exec_impl(command* cmd, mediator* med, const std::string& sql, const std::vector<column_def>& params);
+  static void exec_batch_impl(command* cmd, mediator* med, const std::string& sql);
+
 public:
-  explicit threaded_command(std::shared_ptr<command_allocator> allocator);
+  explicit threaded_command
+    ( std::shared_ptr<command_allocator> allocator
+    , size_t pages = PageRingSize
+    , executor& exec = executor::singleton()
+    , std::shared_ptr<brig::detail::byte_budget> budget = std::shared_ptr<brig::detail::byte_budget>()
+    );
   ~threaded_command() override  { m_med->stop(); }
   void exec(const std::string& sql, const std::vector<column_def>& params) override;
   void exec_batch(const std::string& sql) override;
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
+  bool fetch_view(std::vector<variant>& row) override;
   void set_autocommit(bool autocommit) override;
   void commit() override;
+  void reset() override;
   DBMS system() override;
   std::string sql_param(size_t order) override;
   bool readable_geom() override;
   bool writable_geom() override;
+  fetch_stats get_fetch_stats() override;
+  void cancel() override;
 }; // threaded_command
 
-inline threaded_command::threaded_command(std::shared_ptr<command_allocator> allocator) : m_med(new mediator())
+inline threaded_command::threaded_command(std::shared_ptr<command_allocator> allocator, size_t pages, executor& exec, std::shared_ptr<brig::detail::byte_budget> budget)
+  : m_med(new mediator(allocator, pages, budget)), m_info(false)
+{
+  using namespace std;
+  weak_ptr<mediator> weak(m_med);
+  m_med->set_scheduler([weak, &exec]()
+  {
+    shared_ptr<mediator> med(weak.lock());
+    if (med) exec.submit(bind(&threaded_command::run, med));
+  });
+  exec.submit(bind(&threaded_command::run, m_med));
+}
+
+inline void threaded_command::run(std::shared_ptr<mediator> med)
 {
   using namespace std;
-  auto worker = [](shared_ptr<command_allocator> allocator, shared_ptr<mediator> med)
+  if (!med->cmd)
   {
-    unique_ptr<command> cmd;
-    try  { cmd = unique_ptr<command>(allocator->allocate()); }
+    try
+    {
+      unique_ptr<command> cmd(med->allocator->allocate());
+      lock_guard<mutex> lock(med->cancel_mut);
+      med->cmd = move(cmd);
+    }
     catch (const exception&)  { med->stop(current_exception()); return; }
+    med->allocator.reset();
     med->start();
-    while (med->handle(cmd.get())) med->dpg.prefill(cmd.get());
-  };
-  thread t(worker, allocator, m_med);
-  t.detach();
+  }
+  while (med->handle(med->cmd.get(), false))
+    if (med->ring.ready()) med->ring.fill(med->cmd.get());
+    else if (med->suspend()) return;
+  lock_guard<mutex> lock(med->cancel_mut);
+  med->cmd.reset();
+}
+
+inline void threaded_command::get_info()
+{
+  if (m_info) return;
+  m_med->call_batch
+    ( [&](command* cmd){ m_sys = cmd->system(); }
+    , [&](command* cmd){ m_readable_geom = cmd->readable_geom(); }
+    , [&](command* cmd){ m_writable_geom = cmd->writable_geom(); }
+    );
+  m_info = true;
+}
+
+inline void threaded_command::exec_impl(command* cmd, mediator* med, const std::string& sql, const std::vector<column_def>& params)
+{
+  med->ring.reset();
+  cmd->exec(sql, params);
+}
+
+inline void threaded_command::exec_batch_impl(command* cmd, mediator* med, const std::string& sql)
+{
+  med->ring.reset();
+  cmd->exec_batch(sql);
 }
 
 inline void threaded_command::exec(const std::string& sql, const std::vector<column_def>& params)
 {
-  m_med->dpg.clear();
-  m_med->call<void>(&command::exec, std::placeholders::_1, std::cref(sql), std::cref(params));
+  m_med->call<void>(&threaded_command::exec_impl, std::placeholders::_1, m_med.get(), std::cref(sql), std::cref(params));
 }
 
 inline void threaded_command::exec_batch(const std::string& sql)
 {
-  m_med->dpg.clear();
-  m_med->call<void>(&command::exec_batch, std::placeholders::_1, std::cref(sql));
+  m_med->call<void>(&threaded_command::exec_batch_impl, std::placeholders::_1, m_med.get(), std::cref(sql));
 }
 
 inline std::vector<std::string> threaded_command::columns()
@@ -65,8 +136,12 @@ inline std::vector<std::string> threaded_command::columns()
 
 inline bool threaded_command::fetch(std::vector<variant>& row)
 {
-  if (m_med->dpg.empty()) m_med->call<void>(&brig::detail::double_page::fill, &m_med->dpg, std::placeholders::_1);
-  return m_med->dpg.fetch(row);
+  return m_med->ring.fetch(row);
+}
+
+inline bool threaded_command::fetch_view(std::vector<variant>& row)
+{
+  return m_med->ring.fetch_view(row);
 }
 
 inline void threaded_command::set_autocommit(bool autocommit)
@@ -79,24 +154,48 @@ inline void threaded_command::commit()
   m_med->call<void>(&command::commit, std::placeholders::_1);
 }
 
+inline void threaded_command::reset()
+{
+  m_med->call<void>(&command::reset, std::placeholders::_1);
+}
+
 inline DBMS threaded_command::system()
 {
-  return m_med->call<DBMS>(&command::system, std::placeholders::_1);
+  get_info();
+  return m_sys;
 }
 
 inline std::string threaded_command::sql_param(size_t order)
 {
-  return m_med->call<std::string>(&command::sql_param, std::placeholders::_1, order);
+  while (m_params.size() <= order)
+  {
+    const size_t param(m_params.size());
+    m_params.push_back(m_med->call<std::string>(&command::sql_param, std::placeholders::_1, param));
+  }
+  return m_params[order];
 }
 
 inline bool threaded_command::readable_geom()
 {
-  return m_med->call<bool>(&command::readable_geom, std::placeholders::_1);
+  get_info();
+  return m_readable_geom;
 }
 
 inline bool threaded_command::writable_geom()
 {
-  return m_med->call<bool>(&command::writable_geom, std::placeholders::_1);
+  get_info();
+  return m_writable_geom;
+}
+
+inline fetch_stats threaded_command::get_fetch_stats()
+{
+  return m_med->call<fetch_stats>(&command::get_fetch_stats, std::placeholders::_1);
+}
+
+inline void threaded_command::cancel()
+{
+  std::lock_guard<std::mutex> lock(m_med->cancel_mut); // bypasses the mediator, the producer is blocked in the call
+  if (m_med->cmd) m_med->cmd->cancel();
 } // threaded_command::
 
 } } } // brig::database::detail
@@ -5,15 +5,28 @@
 
 #include <brig/database/command_allocator.hpp>
 #include <brig/database/detail/threaded_command.hpp>
+#include <brig/detail/byte_budget.hpp>
+#include <brig/executor.hpp>
+#include <brig/global.hpp>
 #include <memory>
 
 namespace brig { namespace database { namespace detail {
 
 class threaded_command_allocator : public command_allocator {
   std::shared_ptr<command_allocator> m_allocator;
+  size_t m_pages;
+  executor& m_exec;
+  std::shared_ptr<brig::detail::byte_budget> m_budget;
 public:
-  explicit threaded_command_allocator(std::shared_ptr<command_allocator> allocator) : m_allocator(allocator)  {}
-  command* allocate() override  { return new threaded_command(m_allocator); }
+  explicit threaded_command_allocator
+    ( std::shared_ptr<command_allocator> allocator
+    , size_t pages = PageRingSize
+    , executor& exec = executor::singleton()
+    , std::shared_ptr<brig::detail::byte_budget> budget = std::shared_ptr<brig::detail::byte_budget>()
+    )
+    : m_allocator(allocator), m_pages(pages), m_exec(exec), m_budget(budget)
+    {}
+  command* allocate() override  { return new threaded_command(m_allocator, m_pages, m_exec, m_budget); }
 }; // threaded_command_allocator
 
 } } } // brig::database::detail
@@ -0,0 +1,123 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_DETAIL_TTL_CACHE_HPP
+#define BRIG_DATABASE_DETAIL_TTL_CACHE_HPP
+
+#include <boost/utility.hpp>
+#include <brig/identifier.hpp>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brig { namespace database { namespace detail {
+
+inline std::string cache_key(const identifier& id)  { return id.schema + '\n' + id.name + '\n' + id.qualifier; }
+
+inline std::string cache_key(const identifier& id, const std::vector<std::string>& cols)
+{
+  std::string key(cache_key(id));
+  for (const auto& col: cols) key += '\n' + col;
+  return key;
+}
+
+/*!
+values are loaded outside the lock, a value loaded before any invalidation is not stored,
+keys are cache_key(): erase(cache_key(id)) also erases cache_key(id, cols)
+*/
+template <typename T>
+class ttl_cache : ::boost::noncopyable {
+  typedef std::chrono::steady_clock clock;
+  struct entry {
+    T value;
+    clock::time_point expires;
+  }; // entry
+
+  std::mutex m_mut;
+  std::map<std::string, entry> m_entries;
+  std::chrono::seconds m_ttl;
+  size_t m_generation;
+
+public:
+  explicit ttl_cache(size_t ttl_sec) : m_ttl(ttl_sec), m_generation(0)  {}
+  bool find(const std::string& key, T& val, size_t& generation); // generation is passed to insert() if not found
+  void insert(const std::string& key, const T& val, size_t generation);
+  template <typename Loader> T get(const std::string& key, Loader load);
+  void erase(const std::string& key);
+  void clear();
+  void set_ttl(size_t ttl_sec);
+}; // ttl_cache
+
+template <typename T>
+bool ttl_cache<T>::find(const std::string& key, T& val, size_t& generation)
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  auto iter(m_entries.find(key));
+  if (iter != m_entries.end())
+  {
+    if (clock::now() < iter->second.expires)
+    {
+      val = iter->second.value;
+      return true;
+    }
+    m_entries.erase(iter);
+  }
+  generation = m_generation;
+  return false;
+}
+
+template <typename T>
+void ttl_cache<T>::insert(const std::string& key, const T& val, size_t generation)
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  if (generation != m_generation || m_ttl.count() == 0) return;
+  entry& ent(m_entries[key]);
+  ent.value = val;
+  ent.expires = clock::now() + m_ttl;
+}
+
+template <typename T>
+template <typename Loader>
+T ttl_cache<T>::get(const std::string& key, Loader load)
+{
+  T val;
+  size_t generation(0);
+  if (find(key, val, generation)) return val;
+  val = load();
+  insert(key, val, generation);
+  return val;
+}
+
+template <typename T>
+void ttl_cache<T>::erase(const std::string& key)
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  ++m_generation;
+  m_entries.erase(key);
+  const std::string prefix(key + '\n');
+  auto iter(m_entries.lower_bound(prefix));
+  while (iter != m_entries.end() && iter->first.compare(0, prefix.size(), prefix) == 0)
+    iter = m_entries.erase(iter);
+}
+
+template <typename T>
+void ttl_cache<T>::clear()
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  ++m_generation;
+  m_entries.clear();
+}
+
+template <typename T>
+void ttl_cache<T>::set_ttl(size_t ttl_sec)
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  ++m_generation;
+  m_entries.clear();
+  m_ttl = std::chrono::seconds(ttl_sec);
+} // ttl_cache::
+
+} } } // brig::database::detail
+
+#endif // BRIG_DATABASE_DETAIL_TTL_CACHE_HPP
@@ -0,0 +1,22 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_FETCH_STATS_HPP
+#define BRIG_DATABASE_FETCH_STATS_HPP
+
+#include <cstddef>
+
+namespace brig { namespace database {
+
+struct fetch_stats {
+  size_t fetch_size; // rows per round trip chosen for the next fetch, zero if the backend is not tuned
+  size_t round_trips, rows, bytes;
+  double seconds; // spent in round trips
+
+  fetch_stats() : fetch_size(0), round_trips(0), rows(0), bytes(0), seconds(0)  {}
+  double rows_per_sec() const  { return seconds > 0? rows / seconds: 0; }
+  double bytes_per_row() const  { return rows > 0? double(bytes) / rows: 0; }
+}; // fetch_stats
+
+} } // brig::database
+
+#endif // BRIG_DATABASE_FETCH_STATS_HPP
@@ -19,6 +19,8 @@ struct bind_param_visitor : ::boost::static_visitor<void> {
   void operator()(const double& r) const  { b.buffer_type = MYSQL_TYPE_DOUBLE; b.buffer = (char*)&r; }
   void operator()(const std::string& r) const  { b.buffer_type = MYSQL_TYPE_STRING; b.buffer = (char*)r.c_str(); b.buffer_length = (unsigned long)r.size(); }
   void operator()(const blob_t& r) const  { b.buffer_type = MYSQL_TYPE_BLOB; b.buffer = (char*)r.data(); b.buffer_length = (unsigned long)r.size(); }
+  void operator()(const string_view& r) const  { b.buffer_type = MYSQL_TYPE_STRING; b.buffer = (char*)r.data(); b.buffer_length = (unsigned long)r.size(); }
+  void operator()(const blob_view& r) const  { b.buffer_type = MYSQL_TYPE_BLOB; b.buffer = (char*)r.data(); b.buffer_length = (unsigned long)r.size(); }
 }; // bind_param_visitor
 
 inline void bind_param(const variant& param, MYSQL_BIND& bind)
@@ -5,6 +5,7 @@
 
 #include <brig/database/mysql/detail/bind_result.hpp>
 #include <brig/database/mysql/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/null_t.hpp>
 #include <brig/variant.hpp>
 #include <cstring>
@@ -43,8 +44,7 @@ int bind_result_arr<T, TypeID>::operator()(MYSQL_STMT* stmt, unsigned int col, v
 
     if (r == 0)
     {
-      var = T();
-      T& arr = ::boost::get<T>(var);
+      T& arr = brig::detail::recycle<T>(var);
       arr.resize(size_t(m_lenght));
       if (!arr.empty()) memcpy((void*)arr.data(), m_arr.data(), arr.size());
     }
@@ -6,11 +6,14 @@
 #include <algorithm>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <brig/database/command.hpp>
+#include <brig/database/detail/statement_cache.hpp>
 #include <brig/database/mysql/detail/bind_param.hpp>
 #include <brig/database/mysql/detail/bind_result_factory.hpp>
 #include <brig/database/mysql/detail/lib.hpp>
 #include <brig/global.hpp>
+#include <brig/string_cast.hpp>
 #include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -18,11 +21,22 @@
 namespace brig { namespace database { namespace mysql { namespace detail {
 
 class command : public brig::database::command {
+  struct statement {
+    MYSQL_STMT* stmt;
+    std::vector<MYSQL_BIND> binds;
+    ::boost::ptr_vector<bind_result> cols; // result buffers stay bound between executions
+  }; // statement
+
   MYSQL* m_con;
+  std::string m_host, m_db, m_usr, m_pwd; // cancel() connects again
+  int m_port;
+  unsigned long m_thread;
   MYSQL_STMT* m_stmt;
+  std::string m_key; // SQL the statement was prepared from
   std::vector<MYSQL_BIND> m_binds;
   ::boost::ptr_vector<bind_result> m_cols;
   bool m_autocommit;
+  brig::database::detail::statement_cache<std::shared_ptr<statement>> m_stmts;
 
   void check(bool r);
   void close_stmt();
@@ -36,8 +50,10 @@ public:
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
   void set_autocommit(bool autocommit) override;
+  void reset() override;
   void commit() override;
   DBMS system() override  { return DBMS::MySQL; }
+  void cancel() override;
 }; // command
 
 inline void command::check(bool r)
@@ -51,23 +67,27 @@ inline void command::check(bool r)
 inline void command::close_stmt()
 {
   if (!m_stmt) return;
-  m_binds.clear();
-  m_cols.clear();
-  MYSQL_STMT* stmt(0); std::swap(stmt, m_stmt);
-  lib::singleton().p_mysql_stmt_close(stmt);
+  auto stmt(std::make_shared<statement>());
+  stmt->stmt = 0; std::swap(stmt->stmt, m_stmt);
+  stmt->binds.swap(m_binds);
+  stmt->cols.swap(m_cols);
+  std::string key; key.swap(m_key);
+  if (lib::singleton().p_mysql_stmt_reset(stmt->stmt) != 0) key = ""; // closed by cache
+  m_stmts.put(key, stmt);
 }
 
 inline void command::close_all()
 {
   m_autocommit = true;
   close_stmt();
+  m_stmts.clear();
   if (!m_con) return;
   MYSQL* con(0); std::swap(con, m_con);
   lib::singleton().p_mysql_close(con);
 }
 
 inline command::command(const std::string& host, int port, const std::string& db, const std::string& usr, const std::string& pwd)
-  : m_con(0), m_stmt(0), m_autocommit(true)
+  : m_con(0), m_host(host), m_db(db), m_usr(usr), m_pwd(pwd), m_port(port), m_thread(0), m_stmt(0), m_autocommit(true), m_stmts([](std::shared_ptr<statement>& stmt)  { lib::singleton().p_mysql_stmt_close(stmt->stmt); })
 {
   if (lib::singleton().empty()) throw std::runtime_error("MySQL error");
   m_con = lib::singleton().p_mysql_init(0);
@@ -76,6 +96,7 @@ inline command::command(const std::string& host, int port, const std::string& db
   {
     check(lib::singleton().p_mysql_real_connect(m_con, host.c_str(), usr.c_str(), pwd.c_str(), db.c_str(), port, 0, CLIENT_MULTI_STATEMENTS) == m_con);
     check(lib::singleton().p_mysql_set_character_set(m_con, "utf8") == 0);
+    m_thread = lib::singleton().p_mysql_thread_id(m_con);
   }
   catch (const std::exception&)  { close_all(); throw; }
 }
@@ -83,9 +104,20 @@ inline command::command(const std::string& host, int port, const std::string& db
 inline void command::exec(const std::string& sql, const std::vector<column_def>& params)
 {
   close_stmt();
-  m_stmt = lib::singleton().p_mysql_stmt_init(m_con);
-  if (!m_stmt) throw std::runtime_error("MySQL error");
-  check(lib::singleton().p_mysql_stmt_prepare(m_stmt, sql.c_str(), (unsigned long)sql.size()) == 0);
+  std::shared_ptr<statement> stmt;
+  if (m_stmts.take(sql, stmt))
+  {
+    m_stmt = stmt->stmt;
+    m_binds.swap(stmt->binds);
+    m_cols.swap(stmt->cols);
+  }
+  else
+  {
+    m_stmt = lib::singleton().p_mysql_stmt_init(m_con);
+    if (!m_stmt) throw std::runtime_error("MySQL error");
+    check(lib::singleton().p_mysql_stmt_prepare(m_stmt, sql.c_str(), (unsigned long)sql.size()) == 0);
+  }
+  m_key = sql;
 
   std::vector<MYSQL_BIND> binds(params.size());
   if (!binds.empty())
@@ -159,12 +191,29 @@ inline void command::set_autocommit(bool autocommit)
   m_autocommit = autocommit;
 }
 
+inline void command::reset()
+{
+  close_stmt();
+  if (!m_autocommit || (m_con->server_status & SERVER_STATUS_IN_TRANS)) check(lib::singleton().p_mysql_query(m_con, "ROLLBACK") == 0);
+  m_autocommit = true;
+}
+
 inline void command::commit()
 {
   close_stmt();
   if (m_autocommit) return;
   check(lib::singleton().p_mysql_query(m_con, "COMMIT") == 0);
   check(lib::singleton().p_mysql_query(m_con, "BEGIN") == 0);
+}
+
+inline void command::cancel()
+{
+  // mysql_kill() is deprecated and the connection is busy, the query is killed from a new one
+  MYSQL* con(lib::singleton().p_mysql_init(0));
+  if (!con) return;
+  if (lib::singleton().p_mysql_real_connect(con, m_host.c_str(), m_usr.c_str(), m_pwd.c_str(), m_db.c_str(), m_port, 0, 0) == con)
+    lib::singleton().p_mysql_query(con, ("KILL QUERY " + string_cast<char>(m_thread)).c_str());
+  lib::singleton().p_mysql_close(con);
 } // command::
 
 } } } } // brig::database::mysql::detail
@@ -32,8 +32,10 @@ public:
   decltype(mysql_stmt_fetch_column) *p_mysql_stmt_fetch_column;
   decltype(mysql_stmt_init) *p_mysql_stmt_init;
   decltype(mysql_stmt_prepare) *p_mysql_stmt_prepare;
+  decltype(mysql_stmt_reset) *p_mysql_stmt_reset;
   decltype(mysql_stmt_result_metadata) *p_mysql_stmt_result_metadata;
   decltype(mysql_store_result) *p_mysql_store_result;
+  decltype(mysql_thread_id) *p_mysql_thread_id;
 
   bool empty() const  { return p_mysql_store_result == 0; }
   static lib& singleton()  { static lib s; return s; }
@@ -62,7 +64,9 @@ inline lib::lib() : p_mysql_store_result(0)
     && (p_mysql_stmt_fetch_column = BRIG_DL_FUNCTION(handle, mysql_stmt_fetch_column))
     && (p_mysql_stmt_init = BRIG_DL_FUNCTION(handle, mysql_stmt_init))
     && (p_mysql_stmt_prepare = BRIG_DL_FUNCTION(handle, mysql_stmt_prepare))
+    && (p_mysql_stmt_reset = BRIG_DL_FUNCTION(handle, mysql_stmt_reset))
     && (p_mysql_stmt_result_metadata = BRIG_DL_FUNCTION(handle, mysql_stmt_result_metadata))
+    && (p_mysql_thread_id = BRIG_DL_FUNCTION(handle, mysql_thread_id))
       ) p_mysql_store_result = BRIG_DL_FUNCTION(handle, mysql_store_result);
 } // lib::
 
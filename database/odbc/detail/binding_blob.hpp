@@ -4,7 +4,7 @@
 #define BRIG_DATABASE_ODBC_DETAIL_BINDING_BLOB_HPP
 
 #include <algorithm>
-#include <brig/blob_t.hpp>
+#include <brig/blob_view.hpp>
 #include <brig/database/odbc/detail/binding.hpp>
 #include <brig/database/odbc/detail/lib.hpp>
 
@@ -15,7 +15,7 @@ class binding_blob : public binding {
   SQLPOINTER m_ptr;
   SQLLEN m_ind;
 public:
-  binding_blob(SQLSMALLINT sql_type, const blob_t& blob) : m_sql_type(sql_type), m_ptr((void*)blob.data()), m_ind(blob.size())  {}
+  binding_blob(SQLSMALLINT sql_type, const blob_view& blob) : m_sql_type(sql_type), m_ptr((void*)blob.data()), m_ind(blob.size())  {}
   SQLSMALLINT c_type() override  { return SQL_C_BINARY; }
   SQLSMALLINT sql_type() override  { return m_sql_type; }
   SQLULEN column_size() override  { return std::max<>(SQLULEN(m_ind), SQLULEN(1)); }
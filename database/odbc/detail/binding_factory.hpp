@@ -31,7 +31,9 @@ public:
   binding* operator()(float v) const  { return new binding_impl<float, SQL_C_FLOAT, SQL_REAL>(v); }
   binding* operator()(double v) const  { return new binding_impl<double, SQL_C_DOUBLE, SQL_DOUBLE>(v); }
   binding* operator()(const std::string& r) const  { return new binding_string(sql_type(), r); }
-  binding* operator()(const blob_t& r) const  { return new binding_blob(sql_type(), r); }
+  binding* operator()(const blob_t& r) const  { return new binding_blob(sql_type(), blob_view(r)); }
+  binding* operator()(const string_view& r) const  { return new binding_string(sql_type(), r.to_string()); }
+  binding* operator()(const blob_view& r) const  { return new binding_blob(sql_type(), r); }
 }; // binding_visitor
 
 inline SQLSMALLINT binding_visitor::c_type() const
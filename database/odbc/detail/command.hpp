@@ -6,11 +6,13 @@
 #include <algorithm>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <brig/database/command.hpp>
+#include <brig/database/detail/statement_cache.hpp>
 #include <brig/database/odbc/detail/binding_factory.hpp>
 #include <brig/database/odbc/detail/get_data_factory.hpp>
 #include <brig/database/odbc/detail/lib.hpp>
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
@@ -19,9 +21,12 @@ namespace brig { namespace database { namespace odbc { namespace detail {
 class command : public brig::database::command {
   SQLHANDLE m_env, m_dbc, m_stmt;
   DBMS m_sys;
-  std::string m_sql;
+  std::string m_sql, m_key; // m_key - SQL the statement was prepared from
   ::boost::ptr_vector<get_data> m_cols;
+  brig::database::detail::statement_cache<SQLHANDLE> m_stmts;
+  std::mutex m_cancel_mut; // m_stmt is swapped while cancel() reads it
 
+  void swap_stmt(SQLHANDLE& stmt)  { std::lock_guard<std::mutex> lock(m_cancel_mut); std::swap(m_stmt, stmt); }
   void close_stmt();
   void close_all();
   void check(SQLSMALLINT type, SQLHANDLE handle, SQLRETURN r);
@@ -35,8 +40,10 @@ public:
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
   void set_autocommit(bool autocommit) override;
+  void reset() override  { set_autocommit(true); } // the transaction state is known locally
   void commit() override;
   DBMS system() override  { return m_sys; }
+  void cancel() override;
 }; // command
 
 inline void command::close_stmt()
@@ -44,9 +51,11 @@ inline void command::close_stmt()
   if (SQL_NULL_HANDLE == m_stmt) return;
   m_cols.clear();
   m_sql = "";
-  SQLHANDLE stmt(SQL_NULL_HANDLE); std::swap(stmt, m_stmt);
+  SQLHANDLE stmt(SQL_NULL_HANDLE); swap_stmt(stmt);
   lib::singleton().p_SQLFreeStmt(stmt, SQL_CLOSE); // Postgres hangs on under Visual Studio IDE
-  lib::singleton().p_SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+  lib::singleton().p_SQLFreeStmt(stmt, SQL_RESET_PARAMS);
+  std::string key; key.swap(m_key);
+  m_stmts.put(key, stmt);
 }
 
 inline void command::close_all()
@@ -54,6 +63,7 @@ inline void command::close_all()
   using namespace std;
 
   close_stmt();
+  m_stmts.clear();
   m_sys = DBMS::Void;
   if (SQL_NULL_HANDLE != m_dbc)
   {
@@ -88,7 +98,9 @@ inline void command::check(SQLSMALLINT type, SQLHANDLE handle, SQLRETURN r)
   throw runtime_error(msg.empty()? "ODBC error": brig::unicode::transform<char>(msg));
 }
 
-inline command::command(const std::string& str) : m_env(SQL_NULL_HANDLE), m_dbc(SQL_NULL_HANDLE), m_stmt(SQL_NULL_HANDLE), m_sys(DBMS::Void)
+inline command::command(const std::string& str)
+  : m_env(SQL_NULL_HANDLE), m_dbc(SQL_NULL_HANDLE), m_stmt(SQL_NULL_HANDLE), m_sys(DBMS::Void)
+  , m_stmts([](SQLHANDLE& stmt)  { lib::singleton().p_SQLFreeHandle(SQL_HANDLE_STMT, stmt); })
 {
   using namespace std;
   using namespace brig::unicode;
@@ -154,10 +166,14 @@ inline void command::exec(const std::string& sql, const std::vector<column_def>&
   {
     close_stmt();
     SQLHANDLE stmt(SQL_NULL_HANDLE);
-    check(SQL_HANDLE_DBC, m_dbc, lib::singleton().p_SQLAllocHandle(SQL_HANDLE_STMT, m_dbc, &stmt));
-    std::swap(m_stmt, stmt);
-    check(SQL_HANDLE_STMT, m_stmt, lib::singleton().p_SQLPrepareW(m_stmt, (SQLWCHAR*)brig::unicode::transform<SQLWCHAR>(sql).c_str(), SQL_NTS));
-    m_sql = sql;
+    if (m_stmts.take(sql, stmt)) swap_stmt(stmt);
+    else
+    {
+      check(SQL_HANDLE_DBC, m_dbc, lib::singleton().p_SQLAllocHandle(SQL_HANDLE_STMT, m_dbc, &stmt));
+      swap_stmt(stmt);
+      check(SQL_HANDLE_STMT, m_stmt, lib::singleton().p_SQLPrepareW(m_stmt, (SQLWCHAR*)brig::unicode::transform<SQLWCHAR>(sql).c_str(), SQL_NTS));
+    }
+    m_sql = m_key = sql;
   }
   else
   {
@@ -263,6 +279,12 @@ inline void command::commit()
   close_stmt();
   if (get_autocommit()) return;
   check(SQL_HANDLE_DBC, m_dbc, lib::singleton().p_SQLEndTran(SQL_HANDLE_DBC, m_dbc, SQL_COMMIT));
+}
+
+inline void command::cancel()
+{
+  std::lock_guard<std::mutex> lock(m_cancel_mut);
+  if (SQL_NULL_HANDLE != m_stmt) lib::singleton().p_SQLCancel(m_stmt);
 } // command::
 
 } } } } // brig::database::odbc::detail
@@ -6,6 +6,7 @@
 #include <brig/blob_t.hpp>
 #include <brig/database/odbc/detail/get_data.hpp>
 #include <brig/database/odbc/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/variant.hpp>
 #include <vector>
 
@@ -17,8 +18,8 @@ struct get_data_blob : get_data {
 
 inline SQLRETURN get_data_blob::operator()(SQLHSTMT stmt, size_t col, variant& var)
 {
-  var = blob_t();
-  blob_t& blob = ::boost::get<blob_t>(var);
+  blob_t& blob = brig::detail::recycle<blob_t>(var);
+  blob.clear();
 
   SQLLEN ind(SQL_NULL_DATA), reserved(0);
   SQLRETURN r(lib::singleton().p_SQLGetData(stmt, SQLUSMALLINT(col + 1), SQL_C_BINARY, SQLPOINTER(1), 0, &ind));
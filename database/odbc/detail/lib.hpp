@@ -17,6 +17,7 @@ class lib {
 public:
   decltype(SQLAllocHandle) *p_SQLAllocHandle;
   decltype(SQLBindParameter) *p_SQLBindParameter;
+  decltype(SQLCancel) *p_SQLCancel;
   decltype(SQLColAttributeW) *p_SQLColAttributeW;
   decltype(SQLDataSourcesW) *p_SQLDataSourcesW;
   decltype(SQLDisconnect) *p_SQLDisconnect;
@@ -47,6 +48,7 @@ inline lib::lib() : p_SQLSetEnvAttr(0)
   if (  handle
     && (p_SQLAllocHandle = BRIG_DL_FUNCTION(handle, SQLAllocHandle))
     && (p_SQLBindParameter = BRIG_DL_FUNCTION(handle, SQLBindParameter))
+    && (p_SQLCancel = BRIG_DL_FUNCTION(handle, SQLCancel))
     && (p_SQLColAttributeW = BRIG_DL_FUNCTION(handle, SQLColAttributeW))
     && (p_SQLDataSourcesW = BRIG_DL_FUNCTION(handle, SQLDataSourcesW))
     && (p_SQLDisconnect = BRIG_DL_FUNCTION(handle, SQLDisconnect))
@@ -28,7 +28,9 @@ struct binding_visitor : ::boost::static_visitor<binding*> {
   binding* operator()(float v) const  { return new binding_impl<float, SQLT_FLT>(hnd, i, v); }
   binding* operator()(double v) const  { return new binding_impl<double, SQLT_FLT>(hnd, i, v); }
   binding* operator()(const std::string& r) const  { return new binding_string(hnd, i, r, get_charset_form(param.type_lcase)); }
-  binding* operator()(const blob_t&) const;
+  binding* operator()(const blob_t& r) const;
+  binding* operator()(const string_view& r) const  { return operator()(r.to_string()); }
+  binding* operator()(const blob_view& r) const;
 }; // binding_visitor
 
 inline binding* binding_visitor::operator()(const null_t&) const
@@ -50,6 +52,14 @@ inline binding* binding_visitor::operator()(const blob_t& r) const
     return new binding_geometry(hnd, i, r, param.srid);
   else
     return new binding_blob(hnd, i, (void*)r.data(), ub4(r.size()));
+}
+
+inline binding* binding_visitor::operator()(const blob_view& r) const
+{
+  if (column_type::Geometry == param.type)
+    return new binding_geometry(hnd, i, r.to_blob(), param.srid);
+  else
+    return new binding_blob(hnd, i, (void*)r.data(), ub4(r.size()));
 } // binding_visitor::
 
 inline binding* binding_factory(handles* hnd, size_t order, const column_def& param)
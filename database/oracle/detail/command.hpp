@@ -5,17 +5,20 @@
 
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <brig/database/command.hpp>
+#include <brig/database/detail/fetch_sizer.hpp>
 #include <brig/database/oracle/detail/binding.hpp>
 #include <brig/database/oracle/detail/binding_factory.hpp>
 #include <brig/database/oracle/detail/define.hpp>
 #include <brig/database/oracle/detail/define_factory.hpp>
 #include <brig/database/oracle/detail/handles.hpp>
 #include <brig/database/oracle/detail/lib.hpp>
+#include <brig/detail/bytes_of.hpp>
 #include <brig/global.hpp>
 #include <brig/identifier.hpp>
 #include <brig/string_cast.hpp>
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
+#include <chrono>
 #include <locale>
 #include <sstream>
 #include <stdexcept>
@@ -27,9 +30,14 @@ class command : public brig::database::command {
   handles m_hnd;
   ::boost::ptr_vector<define> m_cols;
   bool m_autocommit;
+  brig::database::detail::fetch_sizer m_sizer;
+  size_t m_rows, m_bytes; // of the current prefetch window
+  double m_seconds;
 
   void close_stmt();
   void close_all();
+  void set_prefetch();
+  void measure();
 
 public:
   command(const std::string& srv, const std::string& usr, const std::string& pwd);
@@ -39,15 +47,35 @@ public:
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
   void set_autocommit(bool autocommit) override;
+  void reset() override  { set_autocommit(true); } // the transaction state is known locally
   void commit() override;
   DBMS system() override  { return DBMS::Oracle; }
   std::string sql_param(size_t order) override  { return ":" + string_cast<char>(order + 1); }
   bool readable_geom() override { return true; }
   bool writable_geom() override { return true; }
+  fetch_stats get_fetch_stats() override  { return m_sizer.stats(); }
 }; // command
 
+inline void command::set_prefetch()
+{
+  ub4 rows(ub4(m_sizer.size())), bytes(ub4(FetchBytes));
+  m_hnd.check(lib::singleton().p_OCIAttrSet(m_hnd.stmt, OCI_HTYPE_STMT, &rows, 0, OCI_ATTR_PREFETCH_ROWS, m_hnd.err));
+  m_hnd.check(lib::singleton().p_OCIAttrSet(m_hnd.stmt, OCI_HTYPE_STMT, &bytes, 0, OCI_ATTR_PREFETCH_MEMORY, m_hnd.err));
+}
+
+inline void command::measure()
+{
+  const size_t size(m_sizer.size());
+  m_sizer.measure(size, m_rows, m_bytes, m_seconds);
+  m_rows = m_bytes = 0;
+  m_seconds = 0;
+  if (m_hnd.stmt && size != m_sizer.size()) set_prefetch();
+}
+
 inline void command::close_stmt()
 {
+  m_rows = m_bytes = 0; // partial window
+  m_seconds = 0;
   m_cols.clear();
   handles::free_handle((void**)&m_hnd.stmt, OCI_HTYPE_STMT);
 }
@@ -64,7 +92,7 @@ inline void command::close_all()
   handles::free_handle((void**)&m_hnd.env, OCI_HTYPE_ENV);
 }
 
-inline command::command(const std::string& srv_, const std::string& usr_, const std::string& pwd_) : m_autocommit(true)
+inline command::command(const std::string& srv_, const std::string& usr_, const std::string& pwd_) : m_autocommit(true), m_rows(0), m_bytes(0), m_seconds(0)
 {
   using namespace std;
   using namespace brig::unicode;
@@ -170,8 +198,8 @@ inline std::vector<std::string> command::columns()
     handles::free_descriptor((void**)&dsc, OCI_DTYPE_PARAM);
   }
 
-  ub4 rows = ub4(PageSize);
-  m_hnd.check(lib::singleton().p_OCIAttrSet(m_hnd.stmt, OCI_HTYPE_STMT, &rows, 0, OCI_ATTR_PREFETCH_ROWS, m_hnd.err));
+  m_sizer.start();
+  set_prefetch();
   return cols;
 }
 
@@ -180,13 +208,24 @@ inline bool command::fetch(std::vector<variant>& row)
   if (0 == m_hnd.stmt) return false;
   if (m_cols.empty()) columns();
 
+  using namespace std::chrono;
+  const auto start(steady_clock::now());
   const sword r(lib::singleton().p_OCIStmtFetch2(m_hnd.stmt, m_hnd.err, 1, OCI_FETCH_NEXT, 1, OCI_DEFAULT));
-  if (OCI_NO_DATA == r) return false;
+  m_seconds += duration_cast<duration<double>>(steady_clock::now() - start).count();
+  if (OCI_NO_DATA == r)
+  {
+    measure();
+    return false;
+  }
   m_hnd.check(r);
 
   row.resize(m_cols.size());
   for (size_t i(0); i < m_cols.size(); ++i)
+  {
     m_cols[i](row[i]);
+    m_bytes += brig::detail::bytes_of(row[i]);
+  }
+  if (++m_rows >= m_sizer.size()) measure(); // prefetch window
   return true;
 }
 
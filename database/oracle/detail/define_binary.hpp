@@ -7,6 +7,7 @@
 #include <brig/database/oracle/detail/define.hpp>
 #include <brig/database/oracle/detail/handles.hpp>
 #include <brig/database/oracle/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/variant.hpp>
 #include <climits>
 #include <cstring>
@@ -38,8 +39,7 @@ inline void define_binary::operator()(variant& var)
   else
   {
     const size_t size(m_len);
-    var = blob_t();
-    blob_t& blob = ::boost::get<blob_t>(var);
+    blob_t& blob = brig::detail::recycle<blob_t>(var);
     blob.resize(size);
     memcpy(blob.data(), m_blob.data(), size);
   }
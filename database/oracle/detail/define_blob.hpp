@@ -7,6 +7,7 @@
 #include <brig/database/oracle/detail/define.hpp>
 #include <brig/database/oracle/detail/handles.hpp>
 #include <brig/database/oracle/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/variant.hpp>
 #include <climits>
 #include <cstring>
@@ -79,8 +80,7 @@ inline void define_blob::operator()(variant& var)
     var = null_t();
   else
   {
-    var = blob_t();
-    blob_t& blob = ::boost::get<blob_t>(var);
+    blob_t& blob = brig::detail::recycle<blob_t>(var);
     blob.swap(m_result);
   }
 } // define_blob::
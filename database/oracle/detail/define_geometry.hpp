@@ -10,6 +10,7 @@
 #include <brig/database/oracle/detail/lib.hpp>
 #include <brig/detail/back_insert_iterator.hpp>
 #include <brig/detail/ogc.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/variant.hpp>
 #include <cstdint>
 #include <stdexcept>
@@ -91,8 +92,8 @@ inline void define_geometry::operator()(variant& var)
   }
   uint32_t num_geoms(0);
 
-  var = blob_t();
-  blob_t& blob = ::boost::get<blob_t>(var);
+  blob_t& blob = brig::detail::recycle<blob_t>(var);
+  blob.clear();
   const size_t header_size(sizeof(uint8_t) + 2 * sizeof(uint32_t));
   if (collection) blob.resize(header_size);
   blob.reserve((collection? 3: 1) * header_size + ((ords / dim) * 2 * sizeof(double)) ); // estimate size
@@ -0,0 +1,24 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_POOL_OPTIONS_HPP
+#define BRIG_DATABASE_POOL_OPTIONS_HPP
+
+#include <brig/global.hpp>
+#include <cstddef>
+
+namespace brig { namespace database {
+
+struct pool_options {
+  size_t min_size; // commands opened in background by the provider and never evicted
+  size_t max_size; // commands in use and idle, callers wait for a free one, zero - unlimited
+  size_t max_idle; // idle commands kept for reuse
+  size_t idle_sec; // idle commands above min_size are closed after it
+  bool affinity; // reuse the command previously released by the same thread
+  size_t budget; // bytes of pages fetched ahead by all commands (threading only)
+
+  pool_options() : min_size(PoolMinSize), max_size(0), max_idle(PoolSize), idle_sec(PoolIdleSec), affinity(false), budget(ProviderBudget)  {}
+}; // pool_options
+
+} } // brig::database
+
+#endif // BRIG_DATABASE_POOL_OPTIONS_HPP
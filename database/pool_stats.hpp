@@ -0,0 +1,22 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DATABASE_POOL_STATS_HPP
+#define BRIG_DATABASE_POOL_STATS_HPP
+
+#include <cstddef>
+
+namespace brig { namespace database {
+
+struct pool_stats {
+  size_t hits; // allocations served by an idle command
+  size_t creations, evictions;
+  size_t waits; // allocations blocked by max_size
+  double wait_seconds, create_seconds;
+  size_t idle, busy;
+
+  pool_stats() : hits(0), creations(0), evictions(0), waits(0), wait_seconds(0), create_seconds(0), idle(0), busy(0)  {}
+}; // pool_stats
+
+} } // brig::database
+
+#endif // BRIG_DATABASE_POOL_STATS_HPP
@@ -3,16 +3,16 @@
 #ifndef BRIG_DATABASE_POSTGRES_DETAIL_BINDING_BLOB_HPP
 #define BRIG_DATABASE_POSTGRES_DETAIL_BINDING_BLOB_HPP
 
-#include <brig/blob_t.hpp>
+#include <brig/blob_view.hpp>
 #include <brig/database/postgres/detail/binding.hpp>
 #include <brig/database/postgres/detail/lib.hpp>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
 class binding_blob : public binding {
-  const blob_t& m_blob;
+  blob_view m_blob;
 public:
-  binding_blob(const blob_t& blob) : m_blob(blob)  {}
+  explicit binding_blob(const blob_view& blob) : m_blob(blob)  {}
   Oid type() override  { return PG_TYPE_BYTEA; }
   const char* value() override  { return (const char*)m_blob.data(); }
   int length() override  { return int(m_blob.size()); }
@@ -21,7 +21,9 @@ struct binding_visitor : ::boost::static_visitor<binding*> {
   binding* operator()(float v) const  { return new binding_impl<float, PG_TYPE_FLOAT4>(v); }
   binding* operator()(double v) const  { return new binding_impl<double, PG_TYPE_FLOAT8>(v); }
   binding* operator()(const std::string& r) const  { return new binding_string(r); }
-  binding* operator()(const blob_t& r) const  { return new binding_blob(r); }
+  binding* operator()(const blob_t& r) const  { return new binding_blob(blob_view(r)); }
+  binding* operator()(const string_view& r) const  { return new binding_string(r); }
+  binding* operator()(const blob_view& r) const  { return new binding_blob(r); }
 }; // binding_visitor
 
 inline binding* binding_factory(const variant& param)
@@ -5,16 +5,19 @@
 
 #include <brig/database/postgres/detail/binding.hpp>
 #include <brig/database/postgres/detail/lib.hpp>
+#include <brig/string_view.hpp>
 #include <string>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
 class binding_string : public binding {
-  const std::string& m_str;
+  std::string m_buf; // text format requires null-terminated value
+  string_view m_str;
 public:
   binding_string(const std::string& str) : m_str(str)  {}
+  binding_string(const string_view& str) : m_buf(str.to_string()), m_str(m_buf)  {}
   Oid type() override  { return PG_TYPE_TEXT; }
-  const char* value() override  { return m_str.c_str(); }
+  const char* value() override  { return m_str.data(); }
   int length() override  { return int(m_str.size()); }
   int format() override  { return 0; }
 }; // binding_string
@@ -7,6 +7,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <brig/database/command.hpp>
+#include <brig/database/detail/fetch_sizer.hpp>
+#include <brig/database/detail/statement_cache.hpp>
 #include <brig/database/postgres/detail/binding_factory.hpp>
 #include <brig/database/postgres/detail/get_value_factory.hpp>
 #include <brig/database/postgres/detail/lib.hpp>
@@ -14,25 +16,44 @@
 #include <brig/string_cast.hpp>
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
+#include <chrono>
 #include <locale>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
 class command : public brig::database::command {
+  class reader : public column_reader {
+    command& m_cmd;
+  public:
+    explicit reader(command& cmd) : m_cmd(cmd)  {}
+    size_t size() override  { return m_cmd.m_cols.size(); }
+    column_type type(size_t col) override;
+    void read(size_t col, variant& var) override;
+  }; // reader
+
   PGconn* m_con;
+  PGcancel* m_cancel;
   PGresult* m_res;
   bool m_fetch;
-  ::boost::ptr_vector<get_value> m_cols;
+  std::vector<get_value> m_cols;
   int m_row;
   bool m_autocommit;
+  brig::database::detail::fetch_sizer m_sizer;
+  size_t m_prepared; // counter of statement names
+  brig::database::detail::statement_cache<std::string> m_stmts; // names of prepared statements, cursors can not be prepared
+  reader m_reader; // of the row m_row - 1
 
   void check(bool r);
   void check_command(PGresult* res);
   void close_result();
   void close_all();
+  void fetch_forward();
+  bool next();
+  bool fetch(std::vector<variant>& row, bool view);
 
 public:
   command(const std::string& host, int port, const std::string& db, const std::string& usr, const std::string& pwd);
@@ -40,13 +61,33 @@ public:
   void exec(const std::string& sql, const std::vector<column_def>& params = std::vector<column_def>()) override;
   void exec_batch(const std::string& sql) override;
   std::vector<std::string> columns() override;
-  bool fetch(std::vector<variant>& row) override;
+  bool fetch(std::vector<variant>& row) override  { return fetch(row, false); }
+  bool fetch_view(std::vector<variant>& row) override  { return fetch(row, true); }
+  size_t fetch_batch(column_batch& batch, size_t max_rows) override;
+  bool fetch_lazy(lazy_row& row) override;
   void set_autocommit(bool autocommit) override;
+  void reset() override;
   void commit() override;
   DBMS system() override  { return DBMS::Postgres; }
   std::string sql_param(size_t order) override  { return "$" + string_cast<char>(order + 1); }
+  fetch_stats get_fetch_stats() override  { return m_sizer.stats(); }
+  void cancel() override;
 }; // command
 
+inline column_type command::reader::type(size_t col)
+{
+  if (lib::singleton().p_PQgetisnull(m_cmd.m_res, m_cmd.m_row - 1, int(col))) return column_type::Void;
+  return m_cmd.m_cols[col].type;
+}
+
+inline void command::reader::read(size_t col, variant& var)
+{
+  lib& l(lib::singleton());
+  const int i(m_cmd.m_row - 1);
+  if (l.p_PQgetisnull(m_cmd.m_res, i, int(col))) var = null_t();
+  else m_cmd.m_cols[col].value(l.p_PQgetvalue(m_cmd.m_res, i, int(col)), l.p_PQgetlength(m_cmd.m_res, i, int(col)), var);
+} // command::reader::
+
 inline void command::check(bool r)
 {
   if (r) return;
@@ -74,7 +115,7 @@ inline void command::close_result()
   if (m_fetch)
   {
     m_fetch = false;
-    PGresult* res(lib::singleton().p_PQexec(m_con, "CLOSE BrigCursor; END;"));
+    PGresult* res(lib::singleton().p_PQexec(m_con, m_autocommit? "CLOSE BrigCursor; END;": "CLOSE BrigCursor;"));
     if (res) lib::singleton().p_PQclear(res);
   }
 }
@@ -82,11 +123,34 @@ inline void command::close_result()
 inline void command::close_all()
 {
   close_result();
+  m_stmts.clear();
+  if (m_cancel) lib::singleton().p_PQfreeCancel(m_cancel);
   lib::singleton().p_PQfinish(m_con);
 }
 
+inline void command::fetch_forward()
+{
+  using namespace std;
+  using namespace std::chrono;
+
+  const size_t size(m_sizer.size());
+  const auto start(steady_clock::now());
+  m_res = lib::singleton().p_PQexec(m_con, string("FETCH FORWARD " + string_cast<char>(size) + " FROM BrigCursor").c_str());
+  const double seconds(duration_cast<duration<double>>(steady_clock::now() - start).count());
+  check(PGRES_TUPLES_OK == lib::singleton().p_PQresultStatus(m_res));
+
+  const int rows(lib::singleton().p_PQntuples(m_res)), cols(lib::singleton().p_PQnfields(m_res));
+  size_t bytes(0);
+  for (int i(0); i < rows; ++i)
+    for (int j(0); j < cols; ++j)
+      bytes += lib::singleton().p_PQgetlength(m_res, i, j);
+  m_sizer.measure(size, size_t(rows), bytes, seconds);
+}
+
 inline command::command(const std::string& host, int port, const std::string& db, const std::string& usr, const std::string& pwd)
-  : m_con(0), m_res(0), m_fetch(false), m_row(0), m_autocommit(true)
+  : m_con(0), m_cancel(0), m_res(0), m_fetch(false), m_row(0), m_autocommit(true), m_prepared(0)
+  , m_stmts([this](std::string& name)  { PGresult* res(lib::singleton().p_PQexec(m_con, ("DEALLOCATE " + name).c_str())); if (res) lib::singleton().p_PQclear(res); })
+  , m_reader(*this)
 {
   using namespace std;
 
@@ -96,6 +160,7 @@ inline command::command(const std::string& host, int port, const std::string& db
     const string con("host='" + host + "' port='" + string_cast<char>(port) + "' dbname='" + db + "' user='" + usr + "' password='" + pwd + "' connect_timeout='" + string_cast<char>(TimeoutSec) + "' client_encoding='UTF8'");
     m_con = lib::singleton().p_PQconnectdb((char*)con.c_str());
     check(lib::singleton().p_PQstatus(m_con) == CONNECTION_OK);
+    m_cancel = lib::singleton().p_PQgetCancel(m_con);
     check_command(lib::singleton().p_PQexec(m_con, string("SET statement_timeout TO " + string_cast<char>(TimeoutSec * 1000)).c_str()));
   }
   catch (const exception&)
@@ -126,20 +191,35 @@ inline void command::exec(const std::string& sql, const std::vector<column_def>&
     formats.push_back(bind->format());
   }
 
-  if (m_autocommit && sql.size() > 6 && unicode::transform<char>(sql.substr(0, 6), unicode::lower_case).compare("select") == 0)
+  if (sql.size() > 6 && unicode::transform<char>(sql.substr(0, 6), unicode::lower_case).compare("select") == 0)
   {
-    check_command(lib::singleton().p_PQexec(m_con, "BEGIN"));
+    if (m_autocommit) check_command(lib::singleton().p_PQexec(m_con, "BEGIN"));
     m_fetch = true;
     check_command(lib::singleton().p_PQexecParams(m_con, string("DECLARE BrigCursor BINARY NO SCROLL CURSOR FOR " + sql).c_str(), int(params.size()), types.data(), values.data(), lengths.data(), formats.data(), 1));
-    m_res = lib::singleton().p_PQexec(m_con, string("FETCH FORWARD " + string_cast<char>(PageSize) + " FROM BrigCursor").c_str());
-    check(PGRES_TUPLES_OK == lib::singleton().p_PQresultStatus(m_res));
+    m_sizer.start();
+    fetch_forward();
   }
-  else
+  else if (params.empty())
   {
-    m_res = lib::singleton().p_PQexecParams(m_con, sql.c_str(), int(params.size()), types.data(), values.data(), lengths.data(), formats.data(), 1);
+    m_res = lib::singleton().p_PQexecParams(m_con, sql.c_str(), 0, 0, 0, 0, 0, 1);
     const ExecStatusType r(lib::singleton().p_PQresultStatus(m_res));
     check(r == PGRES_COMMAND_OK || r == PGRES_TUPLES_OK);
   }
+  else // repeated statements (inserter, windows) are prepared once
+  {
+    string key(sql), name;
+    for (auto type: types) key += ' ' + string_cast<char>(type); // the plan depends on parameter types
+    if (!m_stmts.take(key, name))
+    {
+      name = "brig_stmt_" + string_cast<char>(++m_prepared);
+      check_command(lib::singleton().p_PQprepare(m_con, name.c_str(), sql.c_str(), int(params.size()), types.data()));
+    }
+    m_res = lib::singleton().p_PQexecPrepared(m_con, name.c_str(), int(params.size()), values.data(), lengths.data(), formats.data(), 1);
+    const ExecStatusType r(lib::singleton().p_PQresultStatus(m_res));
+    const bool succeeded(r == PGRES_COMMAND_OK || r == PGRES_TUPLES_OK);
+    if (succeeded) m_stmts.put(key, name); // a failed statement is dropped with the connection, DEALLOCATE fails in an aborted transaction
+    check(succeeded);
+  }
 }
 
 inline void command::exec_batch(const std::string& sql)
@@ -164,16 +244,16 @@ inline std::vector<std::string> command::columns()
   return cols;
 }
 
-inline bool command::fetch(std::vector<variant>& row)
+inline bool command::next()
 {
   if (!m_res) return false;
 
   if (m_fetch && m_row >= lib::singleton().p_PQntuples(m_res))
   {
     m_row = 0;
-    lib::singleton().p_PQclear(m_res);
-    m_res = lib::singleton().p_PQexec(m_con, std::string("FETCH FORWARD " + string_cast<char>(PageSize) + " FROM BrigCursor").c_str());
-    check(PGRES_TUPLES_OK == lib::singleton().p_PQresultStatus(m_res));
+    PGresult* res(0); std::swap(res, m_res);
+    lib::singleton().p_PQclear(res);
+    fetch_forward();
   }
 
   if (m_row >= lib::singleton().p_PQntuples(m_res))
@@ -181,18 +261,68 @@ inline bool command::fetch(std::vector<variant>& row)
     close_result();
     return false;
   }
-  
+
   if (m_cols.empty()) columns();
+  ++m_row;
+  return true;
+}
+
+inline bool command::fetch(std::vector<variant>& row, bool view)
+{
+  if (!next()) return false;
   row.resize(m_cols.size());
-  const int i(m_row++);
+  const int i(m_row - 1);
+  lib& l(lib::singleton());
   for (size_t j(0); j < m_cols.size(); ++j)
   {
-    if (lib::singleton().p_PQgetisnull(m_res, i, int(j))) row[j] = null_t();
-    else m_cols[j](m_res, i, int(j), row[j]);
+    if (l.p_PQgetisnull(m_res, i, int(j))) row[j] = null_t();
+    else (view? m_cols[j].view: m_cols[j].value)(l.p_PQgetvalue(m_res, i, int(j)), l.p_PQgetlength(m_res, i, int(j)), row[j]);
   }
   return true;
 }
 
+inline bool command::fetch_lazy(lazy_row& row)
+{
+  if (!next()) return false;
+  row.reset(m_reader);
+  return true;
+}
+
+inline size_t command::fetch_batch(column_batch& batch, size_t max_rows)
+{
+  batch.clear();
+  if (!m_res) return 0;
+
+  while (batch.rows < max_rows)
+  {
+    if (m_fetch && m_row >= lib::singleton().p_PQntuples(m_res))
+    {
+      m_row = 0;
+      PGresult* res(0); std::swap(res, m_res);
+      lib::singleton().p_PQclear(res);
+      fetch_forward();
+    }
+
+    const int count(lib::singleton().p_PQntuples(m_res));
+    if (m_row >= count)
+    {
+      close_result();
+      break;
+    }
+
+    if (m_cols.empty()) columns();
+    batch.columns.resize(m_cols.size());
+    lib& l(lib::singleton());
+    for (; m_row < count && batch.rows < max_rows; ++m_row, ++batch.rows)
+      for (size_t j(0); j < m_cols.size(); ++j)
+      {
+        if (l.p_PQgetisnull(m_res, m_row, int(j))) batch.columns[j].push_null();
+        else m_cols[j].batch(l.p_PQgetvalue(m_res, m_row, int(j)), l.p_PQgetlength(m_res, m_row, int(j)), batch.columns[j]);
+      }
+  }
+  return batch.rows;
+}
+
 inline void command::set_autocommit(bool autocommit)
 {
   close_result();
@@ -201,11 +331,24 @@ inline void command::set_autocommit(bool autocommit)
   m_autocommit = autocommit;
 }
 
+inline void command::reset()
+{
+  close_result();
+  if (lib::singleton().p_PQtransactionStatus(m_con) != PQTRANS_IDLE) check_command(lib::singleton().p_PQexec(m_con, "ROLLBACK"));
+  m_autocommit = true;
+}
+
 inline void command::commit()
 {
   close_result();
   if (m_autocommit) return;
   check_command(lib::singleton().p_PQexec(m_con, "COMMIT; BEGIN;"));
+}
+
+inline void command::cancel()
+{
+  char err[256];
+  if (m_cancel) lib::singleton().p_PQcancel(m_cancel, err, int(sizeof(err))); // the request is sent over a new connection, the statement fails
 } // command::
 
 } } } } // brig::database::postgres::detail
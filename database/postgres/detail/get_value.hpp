@@ -3,17 +3,29 @@
 #ifndef BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_HPP
 #define BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_HPP
 
-#include <boost/utility.hpp>
-#include <brig/database/postgres/detail/lib.hpp>
+#include <brig/column_batch.hpp>
+#include <brig/column_type.hpp>
 #include <brig/variant.hpp>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
-struct get_value : ::boost::noncopyable {
-  virtual ~get_value()  {}
-  virtual void operator()(PGresult* res, int row, int col, variant& var) = 0;
+/*!
+decoders of a column, resolved once by get_value_factory(), they get the binary value and its length
+*/
+struct get_value {
+  column_type type;
+  void (*value)(const char* data, int size, variant& var);
+  void (*view)(const char* data, int size, variant& var);
+  void (*batch)(const char* data, int size, column_batch::column& batch_col);
 }; // get_value
 
+template <typename Getter>
+get_value make_get_value(column_type type)
+{
+  get_value res = { type, &Getter::value, &Getter::view, &Getter::batch };
+  return res;
+}
+
 } } } } // brig::database::postgres::detail
 
 #endif // BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_HPP
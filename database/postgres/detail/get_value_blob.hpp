@@ -4,22 +4,25 @@
 #define BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_BLOB_HPP
 
 #include <brig/blob_t.hpp>
-#include <brig/database/postgres/detail/get_value.hpp>
-#include <brig/database/postgres/detail/lib.hpp>
+#include <brig/blob_view.hpp>
+#include <brig/column_batch.hpp>
+#include <brig/detail/recycle.hpp>
+#include <brig/variant.hpp>
 #include <cstring>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
-struct get_value_blob : get_value {
-  void operator()(PGresult* res, int row, int col, variant& var) override;
+struct get_value_blob {
+  static void value(const char* data, int size, variant& var);
+  static void view(const char* data, int size, variant& var)  { var = blob_view(data, size_t(size)); }
+  static void batch(const char* data, int size, column_batch::column& batch_col)  { batch_col.push(column_type::Blob, data, size_t(size)); }
 }; // get_value_blob
 
-inline void get_value_blob::operator()(PGresult* res, int row, int col, variant& var)
+inline void get_value_blob::value(const char* data, int size, variant& var)
 {
-  var = blob_t();
-  blob_t& blob(::boost::get<blob_t>(var));
-  blob.resize(lib::singleton().p_PQgetlength(res, row, col));
-  memcpy(blob.data(), lib::singleton().p_PQgetvalue(res, row, col), blob.size());
+  blob_t& blob(brig::detail::recycle<blob_t>(var));
+  blob.resize(size);
+  if (size > 0) memcpy(blob.data(), data, blob.size());
 } // get_value_blob::
 
 } } } } // brig::database::postgres::detail
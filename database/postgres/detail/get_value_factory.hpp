@@ -13,19 +13,19 @@
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
-inline get_value* get_value_factory(Oid type)
+inline get_value get_value_factory(Oid type)
 {
   switch (type)
   {
   default: throw std::runtime_error("Postgres type error");
 
-  case PG_TYPE_BOOL: return new get_value_impl<int8_t>();
+  case PG_TYPE_BOOL: return make_get_value<get_value_impl<int8_t>>(column_type::Integer);
 
-  case PG_TYPE_INT2: return new get_value_impl<int16_t>();
-  case PG_TYPE_INT4: return new get_value_impl<int32_t>();
-  case PG_TYPE_INT8: return new get_value_impl<int64_t>();
-  case PG_TYPE_FLOAT4: return new get_value_impl<float>();
-  case PG_TYPE_FLOAT8: return new get_value_impl<double>();
+  case PG_TYPE_INT2: return make_get_value<get_value_impl<int16_t>>(column_type::Integer);
+  case PG_TYPE_INT4: return make_get_value<get_value_impl<int32_t>>(column_type::Integer);
+  case PG_TYPE_INT8: return make_get_value<get_value_impl<int64_t>>(column_type::Integer);
+  case PG_TYPE_FLOAT4: return make_get_value<get_value_impl<float>>(column_type::Double);
+  case PG_TYPE_FLOAT8: return make_get_value<get_value_impl<double>>(column_type::Double);
 
   case PG_TYPE_BPCHAR:
   case PG_TYPE_BPCHARARRAY:
@@ -33,9 +33,9 @@ inline get_value* get_value_factory(Oid type)
   case PG_TYPE_TEXT:
   case PG_TYPE_TEXTARRAY:
   case PG_TYPE_VARCHAR:
-  case PG_TYPE_VARCHARARRAY: return new get_value_string();
+  case PG_TYPE_VARCHARARRAY: return make_get_value<get_value_string>(column_type::String);
 
-  case PG_TYPE_BYTEA: return new get_value_blob();
+  case PG_TYPE_BYTEA: return make_get_value<get_value_blob>(column_type::Blob);
   }
 } // get_value_factory
 
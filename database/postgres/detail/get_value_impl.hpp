@@ -4,28 +4,33 @@
 #define BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_IMPL_HPP
 
 #include <boost/detail/endian.hpp>
-#include <brig/database/postgres/detail/get_value.hpp>
-#include <brig/database/postgres/detail/lib.hpp>
+#include <brig/column_batch.hpp>
 #include <brig/detail/copy.hpp>
+#include <brig/variant.hpp>
 #include <cstdint>
+#include <type_traits>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
 template <typename T>
-struct get_value_impl : get_value {
-  void operator()(PGresult* res, int row, int col, variant& var) override;
+struct get_value_impl {
+  typedef typename std::conditional<std::is_floating_point<T>::value, double, int64_t>::type batch_type;
+  static T get(const char* data);
+  static void value(const char* data, int, variant& var)  { var = get(data); }
+  static void view(const char* data, int size, variant& var)  { value(data, size, var); }
+  static void batch(const char* data, int, column_batch::column& batch_col)  { batch_col.push(batch_type(get(data))); }
 }; // get_value_impl
 
 template <typename T>
-void get_value_impl<T>::operator()(PGresult* res, int row, int col, variant& var)
+T get_value_impl<T>::get(const char* data)
 {
 #if defined BOOST_LITTLE_ENDIAN
   T val;
-  uint8_t *from((uint8_t*)lib::singleton().p_PQgetvalue(res, row, col)), *to((uint8_t*)&val);
+  uint8_t *from((uint8_t*)data), *to((uint8_t*)&val);
   brig::detail::reverse_copy<T>(from, to);
-  var = val;
+  return val;
 #elif defined BOOST_BIG_ENDIAN
-  var = *(const T*)lib::singleton().p_PQgetvalue(res, row, col);
+  return *(const T*)data;
 #else
   #error byte order error
 #endif
@@ -3,24 +3,20 @@
 #ifndef BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_STRING_HPP
 #define BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_STRING_HPP
 
-#include <brig/database/postgres/detail/get_value.hpp>
-#include <brig/database/postgres/detail/lib.hpp>
+#include <brig/column_batch.hpp>
+#include <brig/detail/recycle.hpp>
+#include <brig/string_view.hpp>
+#include <brig/variant.hpp>
 #include <string>
 
 namespace brig { namespace database { namespace postgres { namespace detail {
 
-struct get_value_string : get_value {
-  void operator()(PGresult* res, int row, int col, variant& var) override;
+struct get_value_string {
+  static void value(const char* data, int size, variant& var)  { brig::detail::recycle<std::string>(var).assign(data, size); }
+  static void view(const char* data, int size, variant& var)  { var = string_view(data, size_t(size)); }
+  static void batch(const char* data, int size, column_batch::column& batch_col)  { batch_col.push(column_type::String, data, size_t(size)); }
 }; // get_value_string
 
-inline void get_value_string::operator()(PGresult* res, int row, int col, variant& var)
-{
-  var = std::string
-    ( lib::singleton().p_PQgetvalue(res, row, col)
-    , lib::singleton().p_PQgetlength(res, row, col)
-    );
-} // get_value_string::
-
 } } } } // brig::database::postgres::detail
 
 #endif // BRIG_DATABASE_POSTGRES_DETAIL_GET_VALUE_STRING_HPP
@@ -13,22 +13,28 @@ class lib {
   lib();
 
 public:
+  decltype(PQcancel) *p_PQcancel;
   decltype(PQclear) *p_PQclear;
   decltype(PQconnectdb) *p_PQconnectdb;
   decltype(PQerrorMessage) *p_PQerrorMessage;
   decltype(PQexec) *p_PQexec;
   decltype(PQexecParams) *p_PQexecParams;
+  decltype(PQexecPrepared) *p_PQexecPrepared;
   decltype(PQfinish) *p_PQfinish;
   decltype(PQfname) *p_PQfname;
+  decltype(PQfreeCancel) *p_PQfreeCancel;
   decltype(PQftype) *p_PQftype;
+  decltype(PQgetCancel) *p_PQgetCancel;
   decltype(PQgetisnull) *p_PQgetisnull;
   decltype(PQgetlength) *p_PQgetlength;
   decltype(PQgetvalue) *p_PQgetvalue;
   decltype(PQlibVersion) *p_PQlibVersion;
   decltype(PQnfields) *p_PQnfields;
   decltype(PQntuples) *p_PQntuples;
+  decltype(PQprepare) *p_PQprepare;
   decltype(PQresultStatus) *p_PQresultStatus;
   decltype(PQstatus) *p_PQstatus;
+  decltype(PQtransactionStatus) *p_PQtransactionStatus;
 
   bool empty() const  { return p_PQstatus == 0; }
   static lib& singleton()  { static lib s; return s; }
@@ -38,21 +44,27 @@ inline lib::lib() : p_PQstatus(0)
 {
   auto handle = BRIG_DL_LIBRARY(LibPostgresWin, LibPostgresLin);
   if (  handle
+    && (p_PQcancel = BRIG_DL_FUNCTION(handle, PQcancel))
     && (p_PQclear = BRIG_DL_FUNCTION(handle, PQclear))
     && (p_PQconnectdb = BRIG_DL_FUNCTION(handle, PQconnectdb))
     && (p_PQerrorMessage = BRIG_DL_FUNCTION(handle, PQerrorMessage))
     && (p_PQexec = BRIG_DL_FUNCTION(handle, PQexec))
     && (p_PQexecParams = BRIG_DL_FUNCTION(handle, PQexecParams))
+    && (p_PQexecPrepared = BRIG_DL_FUNCTION(handle, PQexecPrepared))
     && (p_PQfinish = BRIG_DL_FUNCTION(handle, PQfinish))
     && (p_PQfname = BRIG_DL_FUNCTION(handle, PQfname))
+    && (p_PQfreeCancel = BRIG_DL_FUNCTION(handle, PQfreeCancel))
     && (p_PQftype = BRIG_DL_FUNCTION(handle, PQftype))
+    && (p_PQgetCancel = BRIG_DL_FUNCTION(handle, PQgetCancel))
     && (p_PQgetisnull = BRIG_DL_FUNCTION(handle, PQgetisnull))
     && (p_PQgetlength = BRIG_DL_FUNCTION(handle, PQgetlength))
     && (p_PQgetvalue = BRIG_DL_FUNCTION(handle, PQgetvalue))
     && (p_PQlibVersion = BRIG_DL_FUNCTION(handle, PQlibVersion))
     && (p_PQnfields = BRIG_DL_FUNCTION(handle, PQnfields))
     && (p_PQntuples = BRIG_DL_FUNCTION(handle, PQntuples))
+    && (p_PQprepare = BRIG_DL_FUNCTION(handle, PQprepare))
     && (p_PQresultStatus = BRIG_DL_FUNCTION(handle, PQresultStatus))
+    && (p_PQtransactionStatus = BRIG_DL_FUNCTION(handle, PQtransactionStatus))
      )  p_PQstatus = BRIG_DL_FUNCTION(handle, PQstatus);
 } // lib::
 
@@ -3,26 +3,55 @@
 #ifndef BRIG_DATABASE_PROVIDER_HPP
 #define BRIG_DATABASE_PROVIDER_HPP
 
+#include <brig/boost/as_binary.hpp>
+#include <brig/boost/cover.hpp>
+#include <brig/boost/geom_from_wkb.hpp>
+#include <brig/cancellation_token.hpp>
 #include <brig/database/command_allocator.hpp>
+#include <brig/database/detail/deferred_rowset.hpp>
 #include <brig/database/detail/dialect_factory.hpp>
+#include <brig/database/detail/distinct_rowset.hpp>
 #include <brig/database/detail/fit_raster.hpp>
+#include <brig/database/detail/flight_key.hpp>
 #include <brig/database/detail/get_extent.hpp>
 #include <brig/database/detail/get_geometry_layers.hpp>
+#include <brig/database/detail/get_partitions.hpp>
 #include <brig/database/detail/get_raster_layers.hpp>
 #include <brig/database/detail/get_schema.hpp>
 #include <brig/database/detail/get_srid.hpp>
 #include <brig/database/detail/get_table_def.hpp>
 #include <brig/database/detail/get_tables.hpp>
 #include <brig/database/detail/inserter.hpp>
+#include <brig/database/detail/normalize_hemisphere.hpp>
 #include <brig/database/detail/pool.hpp>
 #include <brig/database/detail/sql_create.hpp>
 #include <brig/database/detail/sql_drop.hpp>
 #include <brig/database/detail/sql_register.hpp>
 #include <brig/database/detail/sql_select.hpp>
+#include <brig/database/detail/sql_select_list.hpp>
+#include <brig/database/detail/spatial_access.hpp>
 #include <brig/database/detail/sql_unregister.hpp>
+#include <brig/database/detail/threaded_command_allocator.hpp>
+#include <brig/database/detail/ttl_cache.hpp>
+#include <brig/database/pool_options.hpp>
+#include <brig/database/pool_stats.hpp>
+#include <brig/detail/byte_budget.hpp>
+#include <brig/detail/cancellable_rowset.hpp>
 #include <brig/detail/deleter.hpp>
+#include <brig/detail/gather_rowset.hpp>
+#include <brig/detail/merged_rowset.hpp>
+#include <brig/detail/shared_rowset.hpp>
+#include <brig/detail/single_flight.hpp>
+#include <brig/executor.hpp>
+#include <brig/global.hpp>
 #include <brig/provider.hpp>
+#include <brig/string_cast.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -30,19 +59,71 @@ namespace brig { namespace database {
 
 template <bool Threading>
 class provider : public brig::provider {
-  typedef detail::pool<Threading> pool_t;
+  typedef detail::pool pool_t;
   typedef brig::detail::deleter<command, pool_t> deleter_t;
   std::shared_ptr<pool_t> m_pool;
+  std::mutex m_mut;
+  std::shared_ptr<detail::dialect> m_dct; // dialects are stateless, shared with per-box sources
+  detail::ttl_cache<std::vector<identifier>> m_tables; // tables and geometry layers
+  detail::ttl_cache<std::vector<pyramid_def>> m_rasters;
+  detail::ttl_cache<table_def> m_table_defs;
+  std::shared_ptr<detail::ttl_cache<boost::box>> m_extents; // shared with inserters
+  detail::ttl_cache<int64_t> m_row_counts; // estimates, negative if unknown
+  std::atomic<bool> m_single_flight;
+  std::atomic<size_t> m_query_boxes;
+  brig::detail::single_flight<table_def> m_table_def_flights;
+  brig::detail::single_flight<boost::box> m_extent_flights;
+  brig::detail::single_flight<std::shared_ptr<const brig::detail::shared_result>> m_select_flights;
+
+  struct invalidator {
+    provider* prv;
+    const identifier* tbl;
+    ~invalidator()  { if (tbl) prv->invalidate(*tbl); else prv->invalidate(); }
+  }; // invalidator
+
+  class inserter_deleter {
+    deleter_t m_deleter;
+    std::shared_ptr<detail::ttl_cache<boost::box>> m_extents;
+    std::string m_key;
+  public:
+    inserter_deleter(const deleter_t& deleter, std::shared_ptr<detail::ttl_cache<boost::box>> extents, const std::string& key) : m_deleter(deleter), m_extents(extents), m_key(key)  {}
+    void operator()(command* cmd) const  { m_extents->erase(m_key); m_deleter(cmd); }
+  }; // inserter_deleter
+
+  class cancellable_deleter {
+    deleter_t m_deleter;
+    std::shared_ptr<cancellation_token::registration> m_reg;
+  public:
+    cancellable_deleter(const deleter_t& deleter, std::shared_ptr<cancellation_token::registration> reg) : m_deleter(deleter), m_reg(reg)  {}
+    void operator()(command* cmd) const  { m_reg->reset(); m_deleter(cmd); }
+  }; // cancellable_deleter
+
+  detail::dialect* get_dialect(command* cmd);
+  template <typename T, typename Fn>
+  T coalesce(brig::detail::single_flight<T>& flights, const std::string& key, Fn fn)  { return m_single_flight? flights.run(key, fn): fn(); }
+  detail::spatial_access plan_select(detail::dialect* dct, command* cmd, const table_def& tbl);
+  void exec_select(command* cmd, const table_def& tbl);
+  std::shared_ptr<command> select_command(const table_def& tbl);
 
 public:
-  explicit provider(std::shared_ptr<command_allocator> allocator) : m_pool(new pool_t(allocator))  {}
+  explicit provider(std::shared_ptr<command_allocator> allocator, const pool_options& options = pool_options());
 
   std::vector<identifier> get_tables() override;
   std::vector<identifier> get_geometry_layers() override;
   std::vector<pyramid_def> get_raster_layers() override;
   table_def get_table_def(const identifier& tbl) override;
+  std::vector<table_def> get_table_defs(const std::vector<identifier>& tbls) override;
   boost::box get_extent(const table_def& tbl) override;
+  /*!
+  a spatial select is planned against the cached extent (see get_extent()) and the row count estimate:
+  the index join for selective boxes, predicates for big boxes and small tables
+  */
   std::shared_ptr<rowset> select(const table_def& tbl) override;
+  /*!
+  the token interrupts the running statement (SQLite - sqlite3_interrupt, Postgres - PQcancel, MySQL - KILL QUERY, ODBC - SQLCancel),
+  so the worker and the connection are freed at once; the select is never coalesced with others
+  */
+  std::shared_ptr<rowset> select(const table_def& tbl, const cancellation_token& token) override;
 
   bool is_readonly() override  { return false; }
   table_def fit_to_create(const table_def& tbl) override;
@@ -54,24 +135,123 @@ public:
   std::shared_ptr<inserter> get_inserter(const table_def& tbl) override;
 
   std::shared_ptr<command> get_command();
+  std::shared_ptr<command> get_command(const cancellation_token& token); // the token cancels the command until it is released
+  pool_stats get_pool_stats()  { return m_pool->stats(); }
+  /*!
+  table list, layers, table definitions and extents are cached for CacheTtlSec (zero - disabled),
+  own create, drop, reg, unreg and inserters invalidate them
+  */
+  void set_cache_ttl(size_t ttl_sec);
+  void invalidate();
+  void invalidate(const identifier& tbl);
+  /*!
+  concurrent identical select, get_table_def and get_extent calls share one execution (off by default),
+  the rows of a shared select are fetched completely and served to every caller from memory
+  */
+  void set_single_flight(bool enabled)  { m_single_flight = enabled; }
+  /*!
+  the query geometry of a spatial select is covered with max_boxes boxes at most instead of its envelope (1 by default),
+  see boost::cover()
+  */
+  void set_query_boxes(size_t max_boxes)  { m_query_boxes = max_boxes; }
+  /*!
+  the scan is split into partitions (SQLite - rowid ranges, Postgres - ctid ranges in the exported snapshot),
+  each one is executed by its own command of the pool, rowsets are merged in no particular order
+  */
+  std::shared_ptr<rowset> select_parallel(const table_def& tbl, size_t partitions);
+  /*!
+  the spatial select is split by the boxes of the query geometry (see set_query_boxes(), geodetic hemispheres),
+  each box is executed by its own command of the pool on detail::async_executor(), rows are gathered in order of arrival
+  and repeated primary keys are skipped; the boxes are planned here, the rowset keeps the pool and the dialect only;
+  select() is used if there is one box or no primary key
+  */
+  std::shared_ptr<rowset> select_per_box(const table_def& tbl);
+  /*!
+  blob columns are selected by the primary key after the others, for DeferredBatchSize rows at once
+  on the first access to the row (fetch() or lazy_row::get() of a blob), so the first rows come without heavy data;
+  select() is used if there is no primary key or blob column
+  */
+  std::shared_ptr<rowset> select_deferred(const table_def& tbl);
   void create(const table_def& tbl, std::vector<std::string>& sql);
   void reg(const pyramid_def& raster, std::vector<std::string>& sql);
 }; // provider
 
+template <bool Threading>
+provider<Threading>::provider(std::shared_ptr<command_allocator> allocator, const pool_options& options)
+  : m_tables(CacheTtlSec), m_rasters(CacheTtlSec), m_table_defs(CacheTtlSec), m_extents(std::make_shared<detail::ttl_cache<boost::box>>(CacheTtlSec)), m_row_counts(CacheTtlSec), m_single_flight(false), m_query_boxes(1)
+{
+  using namespace std;
+  if (Threading) allocator = make_shared<detail::threaded_command_allocator>(allocator, PageRingSize, executor::singleton(), make_shared<brig::detail::byte_budget>(options.budget));
+  m_pool = make_shared<pool_t>(allocator, options);
+  m_pool->warmup();
+}
+
+template <bool Threading>
+detail::dialect* provider<Threading>::get_dialect(command* cmd)
+{
+  std::lock_guard<std::mutex> lck(m_mut);
+  if (!m_dct) m_dct.reset(detail::dialect_factory(cmd->system()));
+  return m_dct.get();
+}
+
+template <bool Threading>
+void provider<Threading>::set_cache_ttl(size_t ttl_sec)
+{
+  m_tables.set_ttl(ttl_sec);
+  m_rasters.set_ttl(ttl_sec);
+  m_table_defs.set_ttl(ttl_sec);
+  m_extents->set_ttl(ttl_sec);
+  m_row_counts.set_ttl(ttl_sec);
+}
+
+template <bool Threading>
+void provider<Threading>::invalidate()
+{
+  m_tables.clear();
+  m_rasters.clear();
+  m_table_defs.clear();
+  m_extents->clear();
+  m_row_counts.clear();
+}
+
+template <bool Threading>
+void provider<Threading>::invalidate(const identifier& tbl)
+{
+  using namespace detail;
+  m_tables.clear();
+  m_rasters.clear(); // levels of pyramids
+  m_table_defs.erase(cache_key(tbl));
+  m_extents->erase(cache_key(tbl));
+  m_row_counts.erase(cache_key(tbl));
+}
+
 template <bool Threading>
 std::shared_ptr<command> provider<Threading>::get_command()
 {
   return std::shared_ptr<command>(m_pool->allocate(), deleter_t(m_pool));
 }
 
+template <bool Threading>
+std::shared_ptr<command> provider<Threading>::get_command(const cancellation_token& token)
+{
+  using namespace std;
+  token.check();
+  unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+  auto reg(make_shared<cancellation_token::registration>(token.subscribe(bind(&command::cancel, cmd.get()))));
+  return shared_ptr<command>(cmd.release(), cancellable_deleter(deleter_t(m_pool), reg));
+}
+
 template <bool Threading>
 std::vector<identifier> provider<Threading>::get_tables()
 {
   using namespace std;
   using namespace detail;
-  unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  return detail::get_tables(dct.get(), cmd.get());
+  return m_tables.get("tables", [&]() -> std::vector<identifier>
+  {
+    unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+    dialect* dct(get_dialect(cmd.get()));
+    return detail::get_tables(dct, cmd.get());
+  });
 }
 
 template <bool Threading>
@@ -79,9 +259,12 @@ std::vector<identifier> provider<Threading>::get_geometry_layers()
 {
   using namespace std;
   using namespace detail;
-  unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  return detail::get_geometry_layers(dct.get(), cmd.get());
+  return m_tables.get("geometry_layers", [&]() -> std::vector<identifier>
+  {
+    unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+    dialect* dct(get_dialect(cmd.get()));
+    return detail::get_geometry_layers(dct, cmd.get());
+  });
 }
 
 template <bool Threading>
@@ -89,9 +272,46 @@ table_def provider<Threading>::get_table_def(const identifier& tbl)
 {
   using namespace std;
   using namespace detail;
+  const string key(cache_key(tbl));
+  return m_table_defs.get(key, [&]() -> table_def
+  {
+    return coalesce(m_table_def_flights, key, [&]() -> table_def
+    {
+      unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+      dialect* dct(get_dialect(cmd.get()));
+      return detail::get_table_def(dct, cmd.get(), tbl);
+    });
+  });
+}
+
+template <bool Threading>
+std::vector<table_def> provider<Threading>::get_table_defs(const std::vector<identifier>& tbls)
+{
+  using namespace std;
+  using namespace detail;
+  vector<table_def> res(tbls.size());
+  vector<identifier> missing;
+  vector<size_t> positions;
+  size_t generation(0);
+  for (size_t i(0); i < tbls.size(); ++i)
+  {
+    size_t tbl_generation(0);
+    if (m_table_defs.find(cache_key(tbls[i]), res[i], tbl_generation)) continue;
+    if (missing.empty()) generation = tbl_generation;
+    missing.push_back(tbls[i]);
+    positions.push_back(i);
+  }
+  if (missing.empty()) return res;
+
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  return detail::get_table_def(dct.get(), cmd.get(), tbl);
+  dialect* dct(get_dialect(cmd.get()));
+  vector<table_def> loaded(detail::get_table_defs(dct, cmd.get(), missing));
+  for (size_t i(0); i < loaded.size(); ++i)
+  {
+    m_table_defs.insert(cache_key(missing[i]), loaded[i], generation);
+    res[positions[i]] = move(loaded[i]);
+  }
+  return res;
 }
 
 template <bool Threading>
@@ -99,9 +319,16 @@ boost::box provider<Threading>::get_extent(const table_def& tbl)
 {
   using namespace std;
   using namespace detail;
-  unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  return detail::get_extent(dct.get(), cmd.get(), tbl);
+  const string key(cache_key(tbl.id, tbl.query_columns));
+  return m_extents->get(key, [&]() -> boost::box
+  {
+    return coalesce(m_extent_flights, key, [&]() -> boost::box
+    {
+      unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+      dialect* dct(get_dialect(cmd.get()));
+      return detail::get_extent(dct, cmd.get(), tbl);
+    });
+  });
 }
 
 template <bool Threading>
@@ -110,11 +337,11 @@ table_def provider<Threading>::fit_to_create(const table_def& tbl)
   using namespace std;
   using namespace detail;
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  table_def res(dct->fit_table(tbl, get_schema(dct.get(), cmd.get())));
+  dialect* dct(get_dialect(cmd.get()));
+  table_def res(dct->fit_table(tbl, get_schema(dct, cmd.get())));
   for (auto& col: res.columns)
     if (col.epsg >= 0)
-      col.srid = get_srid(dct.get(), cmd.get(), col.epsg);
+      col.srid = get_srid(dct, cmd.get(), col.epsg);
   return res;
 }
 
@@ -124,8 +351,8 @@ void provider<Threading>::create(const table_def& tbl, std::vector<std::string>&
   using namespace std;
   using namespace detail;
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  sql_create(dct.get(), tbl, sql);
+  dialect* dct(get_dialect(cmd.get()));
+  sql_create(dct, tbl, sql);
 }
 
 template <bool Threading>
@@ -133,10 +360,11 @@ void provider<Threading>::create(const table_def& tbl)
 {
   using namespace std;
   using namespace detail;
+  const invalidator inv = {this, &tbl.id};
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
+  dialect* dct(get_dialect(cmd.get()));
   vector<string> sql;
-  sql_create(dct.get(), tbl, sql);
+  sql_create(dct, tbl, sql);
   for (const auto& str: sql) cmd->exec(str);
 }
 
@@ -145,10 +373,11 @@ void provider<Threading>::drop(const table_def& tbl)
 {
   using namespace std;
   using namespace detail;
+  const invalidator inv = {this, &tbl.id};
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
+  dialect* dct(get_dialect(cmd.get()));
   vector<string> sql;
-  sql_drop(dct.get(), tbl, sql);
+  sql_drop(dct, tbl, sql);
   for (const auto& str: sql) cmd->exec(str);
 }
 
@@ -157,9 +386,12 @@ std::vector<pyramid_def> provider<Threading>::get_raster_layers()
 {
   using namespace std;
   using namespace detail;
-  unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  return detail::get_raster_layers(dct.get(), cmd.get());
+  return m_rasters.get("raster_layers", [&]() -> std::vector<pyramid_def>
+  {
+    unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+    dialect* dct(get_dialect(cmd.get()));
+    return detail::get_raster_layers(dct, cmd.get());
+  });
 }
 
 template <bool Threading>
@@ -168,8 +400,8 @@ pyramid_def provider<Threading>::fit_to_reg(const pyramid_def& raster)
   using namespace std;
   using namespace detail;
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  return fit_raster(dct.get(), raster, get_schema(dct.get(), cmd.get()));
+  dialect* dct(get_dialect(cmd.get()));
+  return fit_raster(dct, raster, get_schema(dct, cmd.get()));
 }
 
 template <bool Threading>
@@ -178,8 +410,8 @@ void provider<Threading>::reg(const pyramid_def& raster, std::vector<std::string
   using namespace std;
   using namespace detail;
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
-  sql_register(dct.get(), cmd.get(), raster, sql);
+  dialect* dct(get_dialect(cmd.get()));
+  sql_register(dct, cmd.get(), raster, sql);
 }
 
 template <bool Threading>
@@ -187,10 +419,11 @@ void provider<Threading>::reg(const pyramid_def& raster)
 {
   using namespace std;
   using namespace detail;
+  const invalidator inv = {this, 0};
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
+  dialect* dct(get_dialect(cmd.get()));
   vector<string> sql;
-  sql_register(dct.get(), cmd.get(), raster, sql);
+  sql_register(dct, cmd.get(), raster, sql);
   for (const auto& str: sql) cmd->exec(str);
 }
 
@@ -199,10 +432,11 @@ void provider<Threading>::unreg(const pyramid_def& raster)
 {
   using namespace std;
   using namespace detail;
+  const invalidator inv = {this, 0};
   unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
+  dialect* dct(get_dialect(cmd.get()));
   vector<string> sql;
-  sql_unregister(dct.get(), cmd.get(), raster, sql);
+  sql_unregister(dct, cmd.get(), raster, sql);
   for (const auto& str: sql) cmd->exec(str);
 }
 
@@ -210,20 +444,243 @@ template <bool Threading>
 std::shared_ptr<rowset> provider<Threading>::select(const table_def& tbl)
 {
   using namespace std;
-  using namespace detail;
+  if (!m_single_flight) return select_command(tbl);
+  auto res(m_select_flights.run(detail::flight_key(tbl), [&]()  { return brig::detail::materialize(*select_command(tbl)); }));
+  return make_shared<brig::detail::shared_rowset>(res);
+}
+
+template <bool Threading>
+std::shared_ptr<rowset> provider<Threading>::select(const table_def& tbl, const cancellation_token& token)
+{
+  using namespace std;
+  token.check();
   auto cmd(get_command());
-  unique_ptr<dialect> dct(dialect_factory(cmd->system()));
+  auto rs(make_shared<brig::detail::cancellable_rowset>(cmd, token)); // before the execution
+  try  { exec_select(cmd.get(), tbl); }
+  catch (const exception&)  { token.check(); throw; }
+  return rs;
+}
+
+template <bool Threading>
+detail::spatial_access provider<Threading>::plan_select(detail::dialect* dct, command* cmd, const table_def& tbl)
+{
+  using namespace std;
+  using namespace detail;
+  auto geom_col(find_if(begin(tbl.columns), end(tbl.columns), [](const column_def& col){ return column_type::Geometry == col.type && typeid(blob_t) == col.query_value.type(); }));
+  if (geom_col == end(tbl.columns) || geom_col->is_extent_requested() || dct->need_to_normalize_hemisphere(*geom_col)) return spatial_access::Index;
+
+  boost::box extent;
+  size_t generation(0);
+  const bool single(count_if(begin(tbl.columns), end(tbl.columns), [](const column_def& col){ return column_type::Geometry == col.type; }) == 1);
+  if ( !m_extents->find(cache_key(tbl.id, vector<string>(1, geom_col->name)), extent, generation)
+    && !(single && m_extents->find(cache_key(tbl.id), extent, generation))
+     )
+    return spatial_access::Index; // never computed here
+
+  const string key(cache_key(tbl.id));
+  int64_t rows(-1);
+  if (!m_row_counts.find(key, rows, generation))
+  {
+    const string sql(dct->sql_row_count(tbl));
+    if (!sql.empty())
+      try
+      {
+        cmd->exec(sql);
+        vector<variant> row;
+        double val(-1);
+        if (cmd->fetch(row) && numeric_cast(row[0], val) && val >= 0) rows = int64_t(val);
+      }
+      catch (const exception&)  { rows = -1; } // e.g. WITHOUT ROWID table, the estimate is optional
+    m_row_counts.insert(key, rows, generation);
+  }
+  return choose_spatial_access(boost::cover(boost::geom_from_wkb(::boost::get<blob_t>(geom_col->query_value)), m_query_boxes), extent, rows); // the boxes of sql_select()
+}
+
+template <bool Threading>
+void provider<Threading>::exec_select(command* cmd, const table_def& tbl)
+{
+  using namespace std;
+  using namespace detail;
+  dialect* dct(get_dialect(cmd));
+  const spatial_access access(plan_select(dct, cmd, tbl));
   string sql;
   vector<column_def> params;
-  sql_select(dct.get(), cmd.get(), tbl, sql, params);
+  sql_select(dct, cmd, tbl, sql, params, "", access, m_query_boxes);
   cmd->exec(sql, params);
+}
+
+template <bool Threading>
+std::shared_ptr<command> provider<Threading>::select_command(const table_def& tbl)
+{
+  auto cmd(get_command());
+  exec_select(cmd.get(), tbl);
   return cmd;
 }
 
+template <bool Threading>
+std::shared_ptr<rowset> provider<Threading>::select_parallel(const table_def& tbl, size_t partitions)
+{
+  using namespace std;
+  using namespace detail;
+  if (partitions < 2 || tbl.query_rows >= 0) return select(tbl);
+  auto lead(get_command());
+  dialect* dct(get_dialect(lead.get()));
+  const vector<string> conditions(get_partitions(dct, lead.get(), tbl, partitions));
+  if (conditions.size() < 2) return select(tbl);
+
+  vector<string> snapshot;
+  const string sql_snapshot(dct->sql_export_snapshot());
+  if (!sql_snapshot.empty())
+  {
+    lead->set_autocommit(false); // the snapshot lives until all partitions import it
+    lead->exec(sql_snapshot);
+    vector<variant> row;
+    if (!lead->fetch(row)) throw runtime_error("snapshot error");
+    dct->sql_import_snapshot(string_cast<char>(row[0]), snapshot);
+  }
+
+  vector<shared_ptr<rowset>> rowsets;
+  for (const auto& condition: conditions)
+  {
+    auto cmd(get_command());
+    string sql;
+    vector<column_def> params;
+    sql_select(dct, cmd.get(), tbl, sql, params, condition);
+    if (!snapshot.empty())
+    {
+      cmd->set_autocommit(false);
+      for (const auto& str: snapshot) cmd->exec(str);
+    }
+    cmd->exec(sql, params);
+    rowsets.push_back(cmd);
+  }
+  return make_shared<brig::detail::merged_rowset>(rowsets);
+}
+
+template <bool Threading>
+std::shared_ptr<rowset> provider<Threading>::select_per_box(const table_def& tbl)
+{
+  using namespace std;
+  using namespace detail;
+  auto geom_col(find_if(begin(tbl.columns), end(tbl.columns), [](const column_def& col){ return column_type::Geometry == col.type && typeid(blob_t) == col.query_value.type(); }));
+  auto idx(find_if(begin(tbl.indexes), end(tbl.indexes), [](const index_def& i){ return index_type::Primary == i.type; }));
+  if (geom_col == end(tbl.columns) || geom_col->is_extent_requested() || idx == end(tbl.indexes)) return select(tbl);
+
+  vector<boost::box> boxes(boost::cover(boost::geom_from_wkb(::boost::get<blob_t>(geom_col->query_value)), m_query_boxes));
+  unique_ptr<command, deleter_t> cmd(m_pool->allocate(), deleter_t(m_pool));
+  dialect* dct(get_dialect(cmd.get()));
+  if (dct->need_to_normalize_hemisphere(*geom_col)) normalize_hemisphere(boxes);
+  if (boxes.size() < 2)
+  {
+    cmd.reset();
+    return select(tbl);
+  }
+
+  table_def sub(tbl);
+  if (sub.query_columns.empty())
+    for (const auto& col: tbl.columns) sub.query_columns.push_back(col.name);
+  const size_t width(sub.query_columns.size());
+  vector<size_t> keys;
+  for (const auto& key: idx->columns)
+  {
+    auto itr(find(begin(sub.query_columns), end(sub.query_columns), key));
+    keys.push_back(distance(begin(sub.query_columns), itr));
+    if (itr == end(sub.query_columns)) sub.query_columns.push_back(key);
+  }
+
+  // sources do not refer to the provider
+  auto pool(m_pool);
+  shared_ptr<dialect> shared_dct(m_dct); // set by get_dialect()
+  vector<brig::detail::gather_rowset::source> sources;
+  for (const auto& box: boxes)
+  {
+    sub[geom_col->name]->query_value = boost::as_binary(box);
+    const spatial_access access(plan_select(dct, cmd.get(), sub));
+    sources.push_back([pool, shared_dct, sub, access]() -> shared_ptr<rowset>
+    {
+      shared_ptr<command> box_cmd(pool->allocate(), deleter_t(pool));
+      string sql;
+      vector<column_def> params;
+      sql_select(shared_dct.get(), box_cmd.get(), sub, sql, params, "", access);
+      box_cmd->exec(sql, params);
+      return box_cmd;
+    });
+  }
+  cmd.reset(); // back to the pool for the sources
+  return make_shared<distinct_rowset>(make_shared<brig::detail::gather_rowset>(sources), keys, width, tbl.query_rows);
+}
+
+template <bool Threading>
+std::shared_ptr<rowset> provider<Threading>::select_deferred(const table_def& tbl)
+{
+  using namespace std;
+  using namespace detail;
+  const vector<column_def> cols(tbl.query_columns.empty()? tbl.columns: brig::detail::get_columns(tbl.columns, tbl.query_columns));
+  auto pk(find_if(begin(tbl.indexes), end(tbl.indexes), [](const index_def& idx){ return index_type::Primary == idx.type; }));
+  if (pk == end(tbl.indexes) || none_of(begin(cols), end(cols), [](const column_def& col){ return column_type::Blob == col.type; })) return select(tbl);
+
+  table_def light(tbl);
+  light.query_columns.clear();
+  vector<string> names;
+  vector<pair<bool, size_t>> positions;
+  vector<column_def> heavy;
+  for (const auto& col: cols)
+  {
+    names.push_back(col.name);
+    if (column_type::Blob == col.type)
+    {
+      positions.push_back(make_pair(true, heavy.size()));
+      heavy.push_back(col);
+    }
+    else
+    {
+      positions.push_back(make_pair(false, light.query_columns.size()));
+      light.query_columns.push_back(col.name);
+    }
+  }
+  vector<column_def> keys;
+  vector<size_t> key_positions;
+  for (const auto& name: pk->columns)
+  {
+    keys.push_back(*tbl[name]);
+    keys.back().query_expression.clear();
+    keys.back().query_value = null_t();
+    auto light_col(find(begin(light.query_columns), end(light.query_columns), name));
+    key_positions.push_back(size_t(light_col - begin(light.query_columns)));
+    if (light_col == end(light.query_columns)) light.query_columns.push_back(name);
+  }
+  for (auto& col: heavy) col.query_value = null_t();
+
+  auto cmd(get_command());
+  dialect* dct(get_dialect(cmd.get()));
+  vector<column_def> select_list(keys);
+  select_list.insert(end(select_list), begin(heavy), end(heavy));
+  string sql_heavy("SELECT " + sql_select_list(dct, cmd.get(), select_list) + " FROM " + dct->sql_identifier(tbl.id) + " WHERE ");
+  size_t order(0);
+  if (keys.size() == 1) sql_heavy += dct->sql_identifier(keys[0].name) + " IN (";
+  for (size_t i(0); i < DeferredBatchSize; ++i)
+    if (keys.size() == 1) sql_heavy += (i == 0? "": ", ") + dct->sql_parameter(cmd.get(), keys[0], order++);
+    else
+    {
+      sql_heavy += (i == 0? "(": " OR (");
+      for (auto key(begin(keys)); key != end(keys); ++key)
+        sql_heavy += (key == begin(keys)? "": " AND ") + dct->sql_identifier(key->name) + " = " + dct->sql_parameter(cmd.get(), *key, order++);
+      sql_heavy += ")";
+    }
+  if (keys.size() == 1) sql_heavy += ")";
+
+  string sql;
+  vector<column_def> params;
+  sql_select(dct, cmd.get(), light, sql, params);
+  cmd->exec(sql, params);
+  shared_ptr<pool_t> pool(m_pool);
+  return make_shared<deferred_rowset>(cmd, [pool]()  { return shared_ptr<command>(pool->allocate(), deleter_t(pool)); }, names, positions, key_positions, sql_heavy, keys);
+}
+
 template <bool Threading>
 std::shared_ptr<inserter> provider<Threading>::get_inserter(const table_def& tbl)
 {
-  return std::shared_ptr<inserter>(new detail::inserter<deleter_t>(m_pool->allocate(), deleter_t(m_pool), tbl));
+  return std::shared_ptr<inserter>(new detail::inserter<inserter_deleter>(m_pool->allocate(), inserter_deleter(deleter_t(m_pool), m_extents, detail::cache_key(tbl.id)), tbl));
 } // provider::
 
 } } // brig::database
@@ -19,6 +19,8 @@ struct binding_visitor : ::boost::static_visitor<int> {
   int operator()(double v) const  { return lib::singleton().p_sqlite3_bind_double(stmt, i, v); }
   int operator()(const blob_t& r) const  { return lib::singleton().p_sqlite3_bind_blob(stmt, i, r.data(), int(r.size()), SQLITE_STATIC); }
   int operator()(const std::string& r) const  { return lib::singleton().p_sqlite3_bind_text(stmt, i, r.c_str(), -1, SQLITE_STATIC); }
+  int operator()(const blob_view& r) const  { return lib::singleton().p_sqlite3_bind_blob(stmt, i, r.data(), int(r.size()), SQLITE_STATIC); }
+  int operator()(const string_view& r) const  { return lib::singleton().p_sqlite3_bind_text(stmt, i, r.data(), int(r.size()), SQLITE_STATIC); }
 }; // binding_visitor
 
 inline int bind(sqlite3_stmt* stmt, size_t order, const variant& param)
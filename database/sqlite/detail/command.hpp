@@ -5,11 +5,13 @@
 
 #include <algorithm>
 #include <brig/database/command.hpp>
+#include <brig/database/detail/statement_cache.hpp>
 #include <brig/database/detail/is_ogc_type.hpp>
 #include <brig/database/sqlite/detail/binding.hpp>
 #include <brig/database/sqlite/detail/column_geometry.hpp>
 #include <brig/database/sqlite/detail/db_handle.hpp>
 #include <brig/database/sqlite/detail/lib.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/unicode/lower_case.hpp>
 #include <brig/unicode/transform.hpp>
 #include <cstring>
@@ -22,37 +24,74 @@ namespace brig { namespace database { namespace sqlite { namespace detail {
 
 class command : public brig::database::command
 {
-  struct column  { std::string name; bool geometry; };
+  struct column  { std::string name; bool geometry; blob_t wkb; };
+
+  class reader : public column_reader {
+    command& m_cmd;
+  public:
+    explicit reader(command& cmd) : m_cmd(cmd)  {}
+    size_t size() override  { return m_cmd.m_cols.size(); }
+    column_type type(size_t col) override;
+    void read(size_t col, variant& var) override  { m_cmd.read(int(col), var, false); }
+  }; // reader
 
   db_handle m_db;
   sqlite3_stmt* m_stmt;
-  std::string m_sql;
+  std::string m_sql, m_key; // m_key - SQL the statement was prepared from
   std::vector<column> m_cols;
-  bool m_done, m_autocommit;
+  bool m_done, m_autocommit, m_view;
+  brig::database::detail::statement_cache<sqlite3_stmt*> m_stmts;
+  reader m_reader;
 
   void close_stmt();
+  bool step();
+  bool ready();
+  void read(int col, variant& var, bool view);
+  void read(std::vector<variant>& row, bool view);
 
 public:
-  explicit command(const std::string& file) : m_db(file), m_stmt(0), m_done(false), m_autocommit(true)  {}
+  explicit command(const std::string& file)
+    : m_db(file), m_stmt(0), m_done(false), m_autocommit(true), m_view(false), m_stmts([](sqlite3_stmt*& stmt)  { lib::singleton().p_sqlite3_finalize(stmt); }), m_reader(*this)
+    {}
   ~command() override;
   void exec(const std::string& sql, const std::vector<column_def>& params = std::vector<column_def>()) override;
   void exec_batch(const std::string& sql) override;
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
+  bool fetch_view(std::vector<variant>& row) override;
+  size_t fetch_batch(column_batch& batch, size_t max_rows) override;
+  bool fetch_lazy(lazy_row& row) override;
   void set_autocommit(bool autocommit) override;
+  void reset() override;
   void commit() override;
   DBMS system() override  { return DBMS::SQLite; }
   bool readable_geom() override { return true; }
+  void cancel() override  { m_db.interrupt(); }
 }; // command
 
+inline column_type command::reader::type(size_t col)
+{
+  switch (lib::singleton().p_sqlite3_column_type(m_cmd.m_stmt, int(col)))
+  {
+  default: return column_type::Void;
+  case SQLITE_INTEGER: return column_type::Integer;
+  case SQLITE_FLOAT: return column_type::Double;
+  case SQLITE_TEXT: return column_type::String;
+  case SQLITE_BLOB: return m_cmd.m_cols[col].geometry? column_type::Geometry: column_type::Blob;
+  }
+} // command::reader::
+
 inline void command::close_stmt()
 {
   if (!m_stmt) return;
   m_done = false;
+  m_view = false;
   m_cols.clear();
   m_sql = "";
   sqlite3_stmt* stmt(0); std::swap(stmt, m_stmt);
-  lib::singleton().p_sqlite3_finalize(stmt);
+  lib::singleton().p_sqlite3_reset(stmt);
+  m_stmts.put(m_key, stmt);
+  m_key = "";
 }
 
 inline command::~command()
@@ -62,13 +101,35 @@ inline command::~command()
   close_stmt();
 }
 
+inline bool command::step()
+{
+  switch (lib::singleton().p_sqlite3_step(m_stmt))
+  {
+  default: m_db.error(); return false;
+  case SQLITE_ROW: return true;
+  case SQLITE_DONE: m_done = true; return true;
+  }
+}
+
+inline bool command::ready()
+{
+  if (!m_stmt) return false;
+  if (m_view)
+  {
+    m_view = false; // views of the previous row expire here
+    step();
+  }
+  return !m_done;
+}
+
 inline void command::exec(const std::string& sql, const std::vector<column_def>& params)
 {
   if (!m_stmt || sql.empty() || sql != m_sql || !m_done)
   {
     close_stmt();
-    m_stmt = m_db.prepare_stmt(sql);
-    m_sql = sql;
+    sqlite3_stmt* stmt(0);
+    m_stmt = m_stmts.take(sql, stmt)? stmt: m_db.prepare_stmt(sql, true);
+    m_sql = m_key = sql;
   }
   else
   {
@@ -80,12 +141,7 @@ inline void command::exec(const std::string& sql, const std::vector<column_def>&
   for (size_t i(0); i < params.size(); ++i)
     m_db.check(bind(m_stmt, i, params[i].query_value));
 
-  switch (lib::singleton().p_sqlite3_step(m_stmt))
-  {
-  default: m_db.error(); break;
-  case SQLITE_ROW: break;
-  case SQLITE_DONE: m_done = true; break;
-  }
+  step();
 }
 
 inline void command::exec_batch(const std::string& sql)
@@ -116,46 +172,133 @@ inline std::vector<std::string> command::columns()
   return cols;
 }
 
-inline bool command::fetch(std::vector<variant>& row)
+inline void command::read(int i, variant& var, bool view)
 {
-  if (!m_stmt || m_done) return false;
-  if (m_cols.empty()) columns();
+  switch (lib::singleton().p_sqlite3_column_type(m_stmt, i))
+  {
+  default: var = null_t(); break;
+  case SQLITE_INTEGER: var = int64_t(lib::singleton().p_sqlite3_column_int64(m_stmt, i)); break;
+  case SQLITE_FLOAT: var = lib::singleton().p_sqlite3_column_double(m_stmt, i); break;
 
-  const int count = int(m_cols.size());
-  row.resize(count);
-  for (int i(0); i < count; ++i)
-    switch (lib::singleton().p_sqlite3_column_type(m_stmt, i))
+  case SQLITE_TEXT:
     {
-    default: row[i] = null_t(); break;
-    case SQLITE_INTEGER: row[i] = int64_t(lib::singleton().p_sqlite3_column_int64(m_stmt, i)); break;
-    case SQLITE_FLOAT: row[i] = lib::singleton().p_sqlite3_column_double(m_stmt, i); break;
+    const char* text_ptr = (const char*)lib::singleton().p_sqlite3_column_text(m_stmt, i);
+    if (view) var = string_view(text_ptr, size_t(lib::singleton().p_sqlite3_column_bytes(m_stmt, i)));
+    else brig::detail::recycle<std::string>(var) = text_ptr? text_ptr: "";
+    }
+    break;
 
-    case SQLITE_TEXT:
+  case SQLITE_BLOB:
+    if (view)
+    {
+      if (m_cols[i].geometry)
       {
-      const char* text_ptr = (const char*)lib::singleton().p_sqlite3_column_text(m_stmt, i);
-      row[i] = std::string(text_ptr? text_ptr: "");
+        m_cols[i].wkb.clear();
+        column_geometry(m_stmt, i, m_cols[i].wkb);
+        var = blob_view(m_cols[i].wkb);
       }
-      break;
-
-    case SQLITE_BLOB:
-      row[i] = blob_t();
-      brig::blob_t& blob = ::boost::get<brig::blob_t>(row[i]);
-      if (m_cols[i].geometry)
-        column_geometry(m_stmt, i, blob);
       else
       {
-        blob.resize(lib::singleton().p_sqlite3_column_bytes(m_stmt, i));
-        if (!blob.empty()) memcpy(blob.data(), lib::singleton().p_sqlite3_column_blob(m_stmt, i), blob.size());
+        const void* blob_ptr(lib::singleton().p_sqlite3_column_blob(m_stmt, i));
+        var = blob_view(blob_ptr, size_t(lib::singleton().p_sqlite3_column_bytes(m_stmt, i)));
       }
       break;
     }
+    brig::blob_t& blob = brig::detail::recycle<brig::blob_t>(var);
+    if (m_cols[i].geometry)
+    {
+      blob.clear();
+      column_geometry(m_stmt, i, blob);
+    }
+    else
+    {
+      blob.resize(lib::singleton().p_sqlite3_column_bytes(m_stmt, i));
+      if (!blob.empty()) memcpy(blob.data(), lib::singleton().p_sqlite3_column_blob(m_stmt, i), blob.size());
+    }
+    break;
+  }
+}
 
-  switch (lib::singleton().p_sqlite3_step(m_stmt))
+inline void command::read(std::vector<variant>& row, bool view)
+{
+  if (m_cols.empty()) columns();
+
+  const int count = int(m_cols.size());
+  row.resize(count);
+  for (int i(0); i < count; ++i)
+    read(i, row[i], view);
+}
+
+inline bool command::fetch(std::vector<variant>& row)
+{
+  if (!ready()) return false;
+  read(row, false);
+  return step();
+}
+
+inline bool command::fetch_view(std::vector<variant>& row)
+{
+  if (!ready()) return false;
+  read(row, true);
+  m_view = true; // step is deferred to keep driver memory valid
+  return true;
+}
+
+inline bool command::fetch_lazy(lazy_row& row)
+{
+  if (!ready()) return false;
+  if (m_cols.empty()) columns();
+  row.reset(m_reader);
+  m_view = true; // step is deferred, columns are read from the current row
+  return true;
+}
+
+inline size_t command::fetch_batch(column_batch& batch, size_t max_rows)
+{
+  batch.clear();
+  if (!ready()) return 0;
+  if (m_cols.empty()) columns();
+
+  const int count = int(m_cols.size());
+  batch.columns.resize(count);
+  while (batch.rows < max_rows && !m_done)
   {
-  default: m_db.error(); return false;
-  case SQLITE_ROW: return true;
-  case SQLITE_DONE: m_done = true; return true;
+    for (int i(0); i < count; ++i)
+    {
+      column_batch::column& col(batch.columns[i]);
+      switch (lib::singleton().p_sqlite3_column_type(m_stmt, i))
+      {
+      default: col.push_null(); break;
+      case SQLITE_INTEGER: col.push(int64_t(lib::singleton().p_sqlite3_column_int64(m_stmt, i))); break;
+      case SQLITE_FLOAT: col.push(lib::singleton().p_sqlite3_column_double(m_stmt, i)); break;
+
+      case SQLITE_TEXT:
+        {
+        const void* text_ptr(lib::singleton().p_sqlite3_column_text(m_stmt, i));
+        col.push(column_type::String, text_ptr, size_t(lib::singleton().p_sqlite3_column_bytes(m_stmt, i)));
+        }
+        break;
+
+      case SQLITE_BLOB:
+        if (m_cols[i].geometry)
+        {
+          blob_t& wkb(m_cols[i].wkb);
+          wkb.clear();
+          column_geometry(m_stmt, i, wkb);
+          col.push(column_type::Geometry, wkb.data(), wkb.size());
+        }
+        else
+        {
+          const void* blob_ptr(lib::singleton().p_sqlite3_column_blob(m_stmt, i));
+          col.push(column_type::Blob, blob_ptr, size_t(lib::singleton().p_sqlite3_column_bytes(m_stmt, i)));
+        }
+        break;
+      }
+    }
+    ++batch.rows;
+    step();
   }
+  return batch.rows;
 }
 
 inline void command::set_autocommit(bool autocommit)
@@ -166,6 +309,13 @@ inline void command::set_autocommit(bool autocommit)
   m_autocommit = autocommit;
 }
 
+inline void command::reset()
+{
+  close_stmt();
+  if (m_db.in_transaction()) m_db.exec("ROLLBACK");
+  m_autocommit = true;
+}
+
 inline void command::commit()
 {
   close_stmt();
@@ -19,7 +19,9 @@ public:
   void check(int r)  { if (SQLITE_OK != r) error(); }
   void error();
   void exec(const char* sql)  { check(lib::singleton().p_sqlite3_exec(m_db, sql, 0, 0, 0)); }
-  sqlite3_stmt* prepare_stmt(const std::string& sql);
+  bool in_transaction()  { return lib::singleton().p_sqlite3_get_autocommit(m_db) == 0; }
+  void interrupt()  { lib::singleton().p_sqlite3_interrupt(m_db); } // thread-safe
+  sqlite3_stmt* prepare_stmt(const std::string& sql, bool persistent = false); // persistent - long-lived statement of the cache
 }; // db_handle
 
 inline void db_handle::error()
@@ -38,9 +40,16 @@ inline db_handle::db_handle(const std::string& file) : m_db(0)
   std::swap(db, m_db);
 }
 
-inline sqlite3_stmt* db_handle::prepare_stmt(const std::string& sql)
+inline sqlite3_stmt* db_handle::prepare_stmt(const std::string& sql, bool persistent)
 {
   sqlite3_stmt* stmt(0);
+#if SQLITE_VERSION_NUMBER >= 3020000
+  if (persistent && lib::singleton().p_sqlite3_prepare_v3)
+  {
+    check(lib::singleton().p_sqlite3_prepare_v3(m_db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, 0));
+    return stmt;
+  }
+#endif
   check(lib::singleton().p_sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, 0));
   return stmt;
 } // db_handle::
@@ -35,9 +35,14 @@ public:
   decltype(sqlite3_errmsg) *p_sqlite3_errmsg;
   decltype(sqlite3_exec) *p_sqlite3_exec;
   decltype(sqlite3_finalize) *p_sqlite3_finalize;
+  decltype(sqlite3_get_autocommit) *p_sqlite3_get_autocommit;
+  decltype(sqlite3_interrupt) *p_sqlite3_interrupt;
   decltype(sqlite3_libversion) *p_sqlite3_libversion;
   decltype(sqlite3_open) *p_sqlite3_open;
   decltype(sqlite3_prepare_v2) *p_sqlite3_prepare_v2;
+#if SQLITE_VERSION_NUMBER >= 3020000
+  decltype(sqlite3_prepare_v3) *p_sqlite3_prepare_v3; // optional
+#endif
   decltype(sqlite3_reset) *p_sqlite3_reset;
   decltype(sqlite3_step) *p_sqlite3_step;
 
@@ -47,7 +52,11 @@ public:
   static lib& singleton()  { static lib s; return s; }
 }; // lib
 
-inline lib::lib() : p_sqlite3_step(0), p_spatialite_version(0)
+inline lib::lib() :
+#if SQLITE_VERSION_NUMBER >= 3020000
+  p_sqlite3_prepare_v3(0),
+#endif
+  p_sqlite3_step(0), p_spatialite_version(0)
 {
   // SQLite
   auto handle = BRIG_DL_LIBRARY(LibSqliteWin, LibSqliteLin);
@@ -71,11 +80,16 @@ inline lib::lib() : p_sqlite3_step(0), p_spatialite_version(0)
     && (p_sqlite3_errmsg = BRIG_DL_FUNCTION(handle, sqlite3_errmsg))
     && (p_sqlite3_exec = BRIG_DL_FUNCTION(handle, sqlite3_exec))
     && (p_sqlite3_finalize = BRIG_DL_FUNCTION(handle, sqlite3_finalize))
+    && (p_sqlite3_get_autocommit = BRIG_DL_FUNCTION(handle, sqlite3_get_autocommit))
+    && (p_sqlite3_interrupt = BRIG_DL_FUNCTION(handle, sqlite3_interrupt))
     && (p_sqlite3_libversion = BRIG_DL_FUNCTION(handle, sqlite3_libversion))
     && (p_sqlite3_open = BRIG_DL_FUNCTION(handle, sqlite3_open))
     && (p_sqlite3_prepare_v2 = BRIG_DL_FUNCTION(handle, sqlite3_prepare_v2))
     && (p_sqlite3_reset = BRIG_DL_FUNCTION(handle, sqlite3_reset))
      )  p_sqlite3_step = BRIG_DL_FUNCTION(handle, sqlite3_step);
+#if SQLITE_VERSION_NUMBER >= 3020000
+  if (!empty()) p_sqlite3_prepare_v3 = BRIG_DL_FUNCTION(handle, sqlite3_prepare_v3);
+#endif
 
    // SpatiaLite (optional)
    if (!empty())
@@ -0,0 +1,58 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_ARENA_HPP
+#define BRIG_DETAIL_ARENA_HPP
+
+#include <algorithm>
+#include <boost/utility.hpp>
+#include <brig/global.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace brig { namespace detail {
+
+class arena : ::boost::noncopyable { // bump allocator
+  typedef std::pair<std::unique_ptr<uint8_t[]>, size_t> block;
+  std::vector<block> m_blocks;
+  size_t m_used;
+
+  void add_block(size_t size);
+
+public:
+  arena() : m_used(0)  {}
+  void swap(arena& r)  { m_blocks.swap(r.m_blocks); std::swap(m_used, r.m_used); }
+  void* allocate(size_t size);
+  void clear();
+}; // arena
+
+inline void arena::add_block(size_t size)
+{
+  m_blocks.push_back(block(std::unique_ptr<uint8_t[]>(new uint8_t[size]), size));
+  m_used = 0;
+}
+
+inline void* arena::allocate(size_t size)
+{
+  if (m_blocks.empty() || m_blocks.back().second - m_used < size) add_block(std::max<>(PageArenaBlock, size));
+  uint8_t* ptr(m_blocks.back().first.get() + m_used);
+  m_used += size;
+  return ptr;
+}
+
+inline void arena::clear()
+{
+  if (m_blocks.size() > 1) // coalesce, so the next use fits in one block
+  {
+    size_t size(0);
+    for (const auto& blk: m_blocks) size += blk.second;
+    m_blocks.clear();
+    add_block(size);
+  }
+  m_used = 0;
+} // arena::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_ARENA_HPP
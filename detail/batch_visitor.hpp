@@ -0,0 +1,30 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_BATCH_VISITOR_HPP
+#define BRIG_DETAIL_BATCH_VISITOR_HPP
+
+#include <brig/column_type.hpp>
+#include <brig/variant.hpp>
+#include <cstdint>
+#include <string>
+
+namespace brig { namespace detail {
+
+template <typename Column>
+struct batch_visitor : ::boost::static_visitor<void> {
+  Column& col;
+  explicit batch_visitor(Column& col_) : col(col_)  {}
+  void operator()(const null_t&) const  { col.push_null(); }
+  template <typename T>
+  void operator()(T val) const  { col.push(int64_t(val)); }
+  void operator()(float val) const  { col.push(double(val)); }
+  void operator()(double val) const  { col.push(val); }
+  void operator()(const std::string& r) const  { col.push(column_type::String, r.data(), r.size()); }
+  void operator()(const blob_t& r) const  { col.push(column_type::Blob, r.data(), r.size()); }
+  void operator()(const string_view& r) const  { col.push(column_type::String, r.data(), r.size()); }
+  void operator()(const blob_view& r) const  { col.push(column_type::Blob, r.data(), r.size()); }
+}; // batch_visitor
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_BATCH_VISITOR_HPP
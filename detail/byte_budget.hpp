@@ -0,0 +1,30 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_BYTE_BUDGET_HPP
+#define BRIG_DETAIL_BYTE_BUDGET_HPP
+
+#include <atomic>
+#include <boost/utility.hpp>
+#include <cstddef>
+
+namespace brig { namespace detail {
+
+/*!
+soft limit of memory shared by page rings:\n
+* a ring fills ahead only while the budget is available, but it always may fill its first page\n
+*/
+class byte_budget : ::boost::noncopyable {
+  std::atomic<size_t> m_used;
+  const size_t m_limit;
+public:
+  explicit byte_budget(size_t limit) : m_used(0), m_limit(limit)  {}
+  bool available() const  { return m_used < m_limit; }
+  size_t used() const  { return m_used; }
+  size_t limit() const  { return m_limit; }
+  void acquire(size_t bytes)  { m_used += bytes; }
+  void release(size_t bytes)  { m_used -= bytes; }
+}; // byte_budget
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_BYTE_BUDGET_HPP
@@ -0,0 +1,23 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_BYTES_OF_HPP
+#define BRIG_DETAIL_BYTES_OF_HPP
+
+#include <brig/variant.hpp>
+#include <cstddef>
+#include <string>
+
+namespace brig { namespace detail {
+
+inline size_t bytes_of(const variant& var) // approximate
+{
+  if (typeid(std::string) == var.type()) return sizeof(variant) + ::boost::get<std::string>(var).size();
+  if (typeid(blob_t) == var.type()) return sizeof(variant) + ::boost::get<blob_t>(var).size();
+  if (typeid(string_view) == var.type()) return sizeof(variant) + ::boost::get<string_view>(var).size();
+  if (typeid(blob_view) == var.type()) return sizeof(variant) + ::boost::get<blob_view>(var).size();
+  return sizeof(variant);
+}
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_BYTES_OF_HPP
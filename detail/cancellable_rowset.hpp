@@ -0,0 +1,95 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_CANCELLABLE_ROWSET_HPP
+#define BRIG_DETAIL_CANCELLABLE_ROWSET_HPP
+
+#include <brig/cancellation_token.hpp>
+#include <brig/rowset.hpp>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brig { namespace detail {
+
+/*!
+the token cancels the rowset, a result cut short by the cancellation ends with "cancel error" instead of the end of rows
+*/
+class cancellable_rowset : public rowset {
+  std::shared_ptr<rowset> m_rs;
+  cancellation_token m_token;
+  cancellation_token::registration m_reg; // is reset before m_rs is released
+
+public:
+  cancellable_rowset(std::shared_ptr<rowset> rs, const cancellation_token& token);
+  void check() const  { m_token.check(); }
+  std::vector<std::string> columns() override;
+  bool fetch(std::vector<variant>& row) override;
+  bool fetch_view(std::vector<variant>& row) override;
+  size_t fetch_batch(column_batch& batch, size_t max_rows) override;
+  bool fetch_lazy(lazy_row& row) override;
+  void cancel() override  { m_rs->cancel(); }
+}; // cancellable_rowset
+
+inline cancellable_rowset::cancellable_rowset(std::shared_ptr<rowset> rs, const cancellation_token& token)
+  : m_rs(rs), m_token(token), m_reg(token.subscribe(std::bind(&rowset::cancel, rs.get())))
+{
+}
+
+inline std::vector<std::string> cancellable_rowset::columns()
+{
+  m_token.check();
+  try  { return m_rs->columns(); }
+  catch (const std::exception&)  { m_token.check(); throw; }
+}
+
+inline bool cancellable_rowset::fetch(std::vector<variant>& row)
+{
+  m_token.check();
+  try
+  {
+    if (m_rs->fetch(row)) return true;
+  }
+  catch (const std::exception&)  { m_token.check(); throw; }
+  m_token.check();
+  return false;
+}
+
+inline bool cancellable_rowset::fetch_view(std::vector<variant>& row)
+{
+  m_token.check();
+  try
+  {
+    if (m_rs->fetch_view(row)) return true;
+  }
+  catch (const std::exception&)  { m_token.check(); throw; }
+  m_token.check();
+  return false;
+}
+
+inline size_t cancellable_rowset::fetch_batch(column_batch& batch, size_t max_rows)
+{
+  m_token.check();
+  size_t rows(0);
+  try  { rows = m_rs->fetch_batch(batch, max_rows); }
+  catch (const std::exception&)  { m_token.check(); throw; }
+  if (rows == 0) m_token.check();
+  return rows;
+}
+
+inline bool cancellable_rowset::fetch_lazy(lazy_row& row)
+{
+  m_token.check();
+  try
+  {
+    if (m_rs->fetch_lazy(row)) return true;
+  }
+  catch (const std::exception&)  { m_token.check(); throw; }
+  m_token.check();
+  return false;
+} // cancellable_rowset::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_CANCELLABLE_ROWSET_HPP
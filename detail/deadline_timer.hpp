@@ -0,0 +1,84 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_DEADLINE_TIMER_HPP
+#define BRIG_DETAIL_DEADLINE_TIMER_HPP
+
+#include <boost/utility.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace brig { namespace detail {
+
+/*!
+one thread runs the actions of expired deadlines, it is started by the first schedule()
+*/
+class deadline_timer : ::boost::noncopyable {
+  typedef std::chrono::steady_clock clock;
+  std::multimap<clock::time_point, std::function<void()>> m_actions;
+  bool m_stop;
+  std::mutex m_mut;
+  std::condition_variable m_cond;
+  std::thread m_thread;
+
+  void run();
+
+public:
+  deadline_timer() : m_stop(false)  {}
+  ~deadline_timer();
+  void schedule(clock::time_point deadline, std::function<void()> action);
+  static deadline_timer& singleton()  { static deadline_timer s; return s; }
+}; // deadline_timer
+
+inline deadline_timer::~deadline_timer()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mut);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable()) m_thread.join();
+}
+
+inline void deadline_timer::schedule(clock::time_point deadline, std::function<void()> action)
+{
+  std::lock_guard<std::mutex> lock(m_mut);
+  if (!m_thread.joinable()) m_thread = std::thread(&deadline_timer::run, this);
+  const bool earliest(m_actions.empty() || deadline < m_actions.begin()->first);
+  m_actions.insert(std::make_pair(deadline, std::move(action)));
+  if (earliest) m_cond.notify_one();
+}
+
+inline void deadline_timer::run()
+{
+  std::unique_lock<std::mutex> lock(m_mut);
+  while (!m_stop)
+  {
+    if (m_actions.empty())
+    {
+      m_cond.wait(lock);
+      continue;
+    }
+    const clock::time_point deadline(m_actions.begin()->first);
+    if (clock::now() < deadline)
+    {
+      m_cond.wait_until(lock, deadline);
+      continue;
+    }
+    std::function<void()> action(std::move(m_actions.begin()->second));
+    m_actions.erase(m_actions.begin());
+    lock.unlock();
+    try  { action(); }
+    catch (const std::exception&)  {}
+    lock.lock();
+  }
+} // deadline_timer::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_DEADLINE_TIMER_HPP
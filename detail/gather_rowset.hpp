@@ -0,0 +1,186 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_GATHER_ROWSET_HPP
+#define BRIG_DETAIL_GATHER_ROWSET_HPP
+
+#include <algorithm>
+#include <boost/utility.hpp>
+#include <brig/detail/page_cursor.hpp>
+#include <brig/detail/submit_async.hpp>
+#include <brig/global.hpp>
+#include <brig/rowset.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brig { namespace detail {
+
+/*!
+rows of several sources in order of arrival:\n
+* every source is opened and read by pages of PageRows on async_executor(), one page per task\n
+* a source whose page does not fit in the queue (PageRingSize pages per source) is resumed by the consumer\n
+* the first error is thrown to the consumer, the destructor stops the sources\n
+* values keep the types of the sources\n
+*/
+class gather_rowset : public rowset {
+public:
+  typedef std::function<std::shared_ptr<rowset>()> source;
+
+private:
+  struct state : ::boost::noncopyable {
+    std::vector<source> sources;
+    std::vector<std::shared_ptr<rowset>> opened;
+    std::vector<std::string> cols;
+    std::deque<row_page> pages;
+    std::vector<size_t> parked;
+    size_t max_pages, running;
+    bool has_cols, stopped;
+    std::exception_ptr exc;
+    std::mutex mut;
+    std::condition_variable cond;
+  }; // state
+
+  std::shared_ptr<state> m_st;
+  page_cursor m_cur;
+  int m_rows;
+
+  static void step(std::shared_ptr<state> st, size_t i);
+  bool ready();
+  bool fetch(std::vector<variant>& row, bool view);
+
+public:
+  /*!
+  rows < 0 - unlimited, otherwise the rows of all sources are cut off at the limit
+  */
+  explicit gather_rowset(const std::vector<source>& sources, int rows = -1);
+  ~gather_rowset() override;
+  std::vector<std::string> columns() override;
+  bool fetch(std::vector<variant>& row) override  { return fetch(row, false); }
+  bool fetch_view(std::vector<variant>& row) override  { return fetch(row, true); }
+  void cancel() override;
+}; // gather_rowset
+
+inline void gather_rowset::step(std::shared_ptr<state> st, size_t i)
+{
+  using namespace std;
+  shared_ptr<rowset> rs, finished; // released out of the lock
+  {
+    lock_guard<mutex> lock(st->mut);
+    if (st->stopped)
+    {
+      swap(finished, st->opened[i]);
+      --st->running;
+      st->cond.notify_all();
+      return;
+    }
+    rs = st->opened[i];
+  }
+
+  row_page pg;
+  bool more(false);
+  exception_ptr e;
+  try
+  {
+    if (!rs)
+    {
+      rs = st->sources[i]();
+      const vector<string> cols(rs->columns());
+      lock_guard<mutex> lock(st->mut);
+      st->opened[i] = rs;
+      if (!st->has_cols)
+      {
+        st->cols = cols;
+        st->has_cols = true;
+      }
+    }
+    more = read_page(*rs, pg, PageRows) > 0;
+  }
+  catch (const exception&)  { e = current_exception(); }
+
+  lock_guard<mutex> lock(st->mut);
+  if (!(e == 0) && st->exc == 0) st->exc = e;
+  if (more && !st->stopped && st->exc == 0)
+  {
+    st->pages.push_back(std::move(pg)); // not boost::move found by ADL
+    if (st->pages.size() < st->max_pages) async_executor().submit(bind(&gather_rowset::step, st, i));
+    else st->parked.push_back(i);
+  }
+  else
+  {
+    swap(finished, st->opened[i]);
+    --st->running;
+  }
+  st->cond.notify_all();
+}
+
+inline gather_rowset::gather_rowset(const std::vector<source>& sources, int rows) : m_st(std::make_shared<state>()), m_rows(rows)
+{
+  m_st->sources = sources;
+  m_st->opened.resize(sources.size());
+  m_st->max_pages = std::max<>(sources.size() * PageRingSize, size_t(1));
+  m_st->running = sources.size();
+  m_st->has_cols = false;
+  m_st->stopped = false;
+  for (size_t i(0); i < sources.size(); ++i) async_executor().submit(std::bind(&gather_rowset::step, m_st, i));
+}
+
+inline gather_rowset::~gather_rowset()
+{
+  std::vector<size_t> parked;
+  std::lock_guard<std::mutex> lock(m_st->mut);
+  m_st->stopped = true;
+  m_st->pages.clear();
+  std::swap(parked, m_st->parked);
+  for (size_t i: parked) async_executor().submit(std::bind(&gather_rowset::step, m_st, i)); // to release the source
+}
+
+inline std::vector<std::string> gather_rowset::columns()
+{
+  using namespace std;
+  unique_lock<mutex> lock(m_st->mut);
+  m_st->cond.wait(lock, [&]()  { return m_st->has_cols || m_st->running == 0 || !(m_st->exc == 0); });
+  if (!m_st->has_cols && !(m_st->exc == 0)) rethrow_exception(m_st->exc);
+  return m_st->cols;
+}
+
+inline bool gather_rowset::ready()
+{
+  using namespace std;
+  if (m_rows == 0) return false;
+  while (m_cur.empty())
+  {
+    unique_lock<mutex> lock(m_st->mut);
+    m_st->cond.wait(lock, [&]()  { return !m_st->pages.empty() || m_st->running == 0 || !(m_st->exc == 0); });
+    if (!(m_st->exc == 0)) rethrow_exception(m_st->exc);
+    if (m_st->pages.empty()) return false;
+    m_cur.reset(m_st->pages.front());
+    m_st->pages.pop_front();
+    for (size_t i: m_st->parked) async_executor().submit(bind(&gather_rowset::step, m_st, i));
+    m_st->parked.clear();
+  }
+  return true;
+}
+
+inline bool gather_rowset::fetch(std::vector<variant>& row, bool view)
+{
+  if (!ready()) return false;
+  m_cur.fetch(row, view);
+  if (m_rows > 0) --m_rows;
+  return true;
+}
+
+inline void gather_rowset::cancel()
+{
+  std::lock_guard<std::mutex> lock(m_st->mut);
+  for (const auto& rs: m_st->opened)
+    if (rs) rs->cancel();
+} // gather_rowset::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_GATHER_ROWSET_HPP
@@ -3,15 +3,27 @@
 #ifndef BRIG_DETAIL_MEDIATOR_HPP
 #define BRIG_DETAIL_MEDIATOR_HPP
 
+#include <atomic>
 #include <boost/utility.hpp>
+#include <brig/global.hpp>
 #include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace brig { namespace detail {
 
+/*!
+synchronous calls of the interface in its own thread:\n
+* a task lives on the stack of the caller, so a call does not allocate\n
+* both sides spin (yielding) before they park on the condition variable\n
+* the handling side may be a task of an executor, see set_scheduler() and suspend()\n
+*/
 template <typename Interface>
 class mediator : ::boost::noncopyable {
   struct task {
@@ -36,62 +48,117 @@ class mediator : ::boost::noncopyable {
     void result()  {}
   }; // task_impl<void, UnaryFun>
 
-  enum state  { BeforeStart, Idle, Calling, AfterFinish };
-
-  std::mutex m_mut;
-  std::condition_variable m_cond;
-  state m_st;
+  template <typename... UnaryFuns>
+  struct task_batch : task {
+    std::tuple<UnaryFuns&...> fs;
+    explicit task_batch(UnaryFuns&... fs_) : fs(fs_...)  {}
+    void exec(Interface* iface) override  { exec_from<0>(iface); }
+    template <size_t I>
+    typename std::enable_if<I < sizeof...(UnaryFuns)>::type exec_from(Interface* iface)  { std::get<I>(fs)(iface); exec_from<I + 1>(iface); }
+    template <size_t I>
+    typename std::enable_if<I == sizeof...(UnaryFuns)>::type exec_from(Interface*)  {}
+  }; // task_batch<UnaryFuns...>
+
+  enum state  { BeforeStart, Idle, Preparing, Calling, Called, AfterFinish };
+
+  std::atomic<int> m_st;
+  std::atomic<bool> m_woken, m_suspended;
+  std::function<void()> m_schedule;
+  std::atomic<size_t> m_parked;
   task* m_tsk;
   std::exception_ptr m_exc;
+  std::mutex m_mut;
+  std::condition_variable m_cond;
 
-  void set_state(state, const std::exception_ptr&);
+  template <typename Predicate>
+  void wait(Predicate pred);
+  void set_state(state);
+  void resume();
   void exec(task*); // rethrow exception
 
 public:
-  mediator() : m_st(BeforeStart), m_tsk(0)  {}
-  void start()  { set_state(Idle, std::exception_ptr()); }
-  void stop(const std::exception_ptr& exc = std::exception_ptr())  { set_state(AfterFinish, exc); }
+  mediator() : m_st(BeforeStart), m_woken(false), m_suspended(false), m_parked(0), m_tsk(0)  {}
+  void set_scheduler(std::function<void()> schedule)  { m_schedule = schedule; }
+  void start();
+  void stop(const std::exception_ptr& exc = std::exception_ptr())  { m_exc = exc; set_state(AfterFinish); resume(); }
   template<typename Result, typename Fun, typename... Args>
   Result call(Fun&& f, Args&&... args);
   // todo: GCC - decltype(std::bind(std::forward<Fun>(f), std::forward<Args>(args)...)(std::declval<Interface*>()));
   // todo: MSVC November 2012 CTP - typename std::result_of<Fun(Args...)>::type;
-  bool handle(Interface*); // catch exception
+  template<typename... UnaryFuns>
+  void call_batch(UnaryFuns&&... fs); // one round trip, results are discarded
+  bool handle(Interface*, bool wait = true); // catch exception
+  bool suspend(); // @return true if the handling task may return, it will be scheduled on the next call
+  void wake(); // interrupt waiting handle() or schedule suspended task
 }; // mediator
 
 template <typename Interface>
-void mediator<Interface>::set_state(state st, const std::exception_ptr& exc)
+  template <typename Predicate>
+void mediator<Interface>::wait(Predicate pred)
 {
   using namespace std;
+  for (size_t i(0); i < MediatorSpinCount; ++i)
   {
-    unique_lock<mutex> lock(m_mut);
-    m_st = st;
-    m_tsk = 0;
-    m_exc = exc;
+    if (pred()) return;
+    this_thread::yield();
   }
-  m_cond.notify_one();
+  unique_lock<mutex> lock(m_mut);
+  ++m_parked;
+  m_cond.wait(lock, pred);
+  --m_parked;
+}
+
+template <typename Interface>
+void mediator<Interface>::set_state(state st)
+{
+  using namespace std;
+  m_st = st;
+  if (m_parked > 0)
+  {
+    lock_guard<mutex> lock(m_mut);
+    m_cond.notify_all();
+  }
+}
+
+template <typename Interface>
+void mediator<Interface>::resume()
+{
+  if (m_suspended.exchange(false) && m_schedule) m_schedule();
+}
+
+template <typename Interface>
+void mediator<Interface>::start()
+{
+  int st(BeforeStart);
+  if (m_st.compare_exchange_strong(st, Idle)) set_state(Idle);
 }
 
 template <typename Interface>
 void mediator<Interface>::exec(task* tsk)
 {
   using namespace std;
+  int st(Idle);
+  wait([&]() -> bool {
+    st = Idle;
+    if (this->m_st.compare_exchange_strong(st, Preparing)) return true;
+    return AfterFinish == st;
+  });
+  if (AfterFinish == st)
   {
-    unique_lock<mutex> lock(m_mut);
-    m_cond.wait(lock, [&](){ return Idle == this->m_st || AfterFinish == this->m_st; });
-    if (Idle == m_st)
-    {
-      m_st = Calling;
-      m_tsk = tsk;
-      m_exc = exception_ptr();
-    }
+    if (!(m_exc == 0)) rethrow_exception(m_exc);
+    throw runtime_error("thread error");
   }
-  m_cond.notify_one();
+  m_tsk = tsk;
+  m_exc = exception_ptr();
+  set_state(Calling);
+  resume();
 
-  unique_lock<mutex> lock(m_mut);
-  m_cond.wait(lock, [&](){ return Idle == this->m_st || AfterFinish == this->m_st; });
+  wait([&](){ const int st(this->m_st); return Called == st || AfterFinish == st; });
   m_tsk = 0;
-  if (!(m_exc == 0)) rethrow_exception(move(m_exc));
+  exception_ptr exc; swap(exc, m_exc);
   if (AfterFinish == m_st) throw runtime_error("thread error");
+  set_state(Idle);
+  if (!(exc == 0)) rethrow_exception(exc);
 }
 
 template <typename Interface>
@@ -99,28 +166,60 @@ template <typename Interface>
 Result mediator<Interface>::call(Fun&& f, Args&&... args)
 {
   using namespace std;
-  typedef function<Result(Interface*)> UnaryFun;
-  UnaryFun uf(bind(forward<Fun>(f), forward<Args>(args)...));
-  task_impl<Result, UnaryFun> tsk(uf);
+  auto uf(bind(forward<Fun>(f), forward<Args>(args)...));
+  task_impl<Result, decltype(uf)> tsk(uf);
   exec(&tsk);
   return tsk.result();
 }
 
 template <typename Interface>
-bool mediator<Interface>::handle(Interface* arg)
+  template<typename... UnaryFuns>
+void mediator<Interface>::call_batch(UnaryFuns&&... fs)
+{
+  task_batch<typename std::remove_reference<UnaryFuns>::type...> tsk(fs...);
+  exec(&tsk);
+}
+
+template <typename Interface>
+bool mediator<Interface>::handle(Interface* arg, bool wait)
 {
   using namespace std;
+  auto pred = [&](){ const int st(this->m_st); return Calling == st || AfterFinish == st || this->m_woken; };
+  if (wait) this->wait(pred);
+  m_woken = false;
+  const int st(m_st);
+  if (AfterFinish == st) return false;
+  if (Calling != st) return true;
+  try  { m_tsk->exec(arg); }
+  catch (const exception&)  { m_exc = current_exception(); }
+  set_state(Called);
+  return true;
+}
+
+template <typename Interface>
+bool mediator<Interface>::suspend()
+{
+  auto pred = [&](){ const int st(this->m_st); return Calling == st || AfterFinish == st || this->m_woken; };
+  for (size_t i(0); i < MediatorSpinCount; ++i)
   {
-    unique_lock<mutex> lock(m_mut);
-    m_cond.wait(lock, [&](){ return Calling == this->m_st || AfterFinish == this->m_st; });
-    if (AfterFinish == m_st) return false;
+    if (pred()) return false;
+    std::this_thread::yield();
+  }
+  m_suspended = true;
+  if (!pred()) return true;
+  return !m_suspended.exchange(false); // false - resumed by itself
+}
 
-    m_st = Idle;
-    try  { m_tsk->exec(arg); }
-    catch (const exception&)  { m_exc = current_exception(); }
+template <typename Interface>
+void mediator<Interface>::wake()
+{
+  m_woken = true;
+  if (m_parked > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mut);
+    m_cond.notify_all();
   }
-  m_cond.notify_one();
-  return true;
+  resume();
 } // mediator::
 
 } } // brig::detail
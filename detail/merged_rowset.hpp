@@ -0,0 +1,67 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_MERGED_ROWSET_HPP
+#define BRIG_DETAIL_MERGED_ROWSET_HPP
+
+#include <brig/rowset.hpp>
+#include <brig/variant.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brig { namespace detail {
+
+/*!
+union of rowsets with the same columns:\n
+* rows are taken round-robin, so prefetching rowsets (threaded_rowset, threaded_command) are drained together\n
+* the order of rows is not preserved\n
+*/
+class merged_rowset : public rowset {
+  std::vector<std::shared_ptr<rowset>> m_rowsets;
+  size_t m_cur;
+  std::mutex m_mut; // m_rowsets are shrunk by fetch and read by cancel
+
+  template <typename Row, typename Fetch>
+  bool fetch_impl(Row& row, Fetch fetch);
+
+public:
+  explicit merged_rowset(const std::vector<std::shared_ptr<rowset>>& rowsets) : m_rowsets(rowsets), m_cur(0)  {}
+  std::vector<std::string> columns() override;
+  bool fetch(std::vector<variant>& row) override  { return fetch_impl(row, [](rowset* rs, std::vector<variant>& r){ return rs->fetch(r); }); }
+  bool fetch_view(std::vector<variant>& row) override  { return fetch_impl(row, [](rowset* rs, std::vector<variant>& r){ return rs->fetch_view(r); }); }
+  bool fetch_lazy(lazy_row& row) override  { return fetch_impl(row, [](rowset* rs, lazy_row& r){ return rs->fetch_lazy(r); }); }
+  void cancel() override;
+}; // merged_rowset
+
+inline std::vector<std::string> merged_rowset::columns()
+{
+  return m_rowsets.empty()? std::vector<std::string>(): m_rowsets.front()->columns();
+}
+
+template <typename Row, typename Fetch>
+bool merged_rowset::fetch_impl(Row& row, Fetch fetch)
+{
+  while (!m_rowsets.empty())
+  {
+    if (m_cur >= m_rowsets.size()) m_cur = 0;
+    if (fetch(m_rowsets[m_cur].get(), row))
+    {
+      ++m_cur;
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(m_mut);
+    m_rowsets.erase(m_rowsets.begin() + m_cur);
+  }
+  return false;
+}
+
+inline void merged_rowset::cancel()
+{
+  std::lock_guard<std::mutex> lock(m_mut);
+  for (auto& rs: m_rowsets) rs->cancel();
+} // merged_rowset::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_MERGED_ROWSET_HPP
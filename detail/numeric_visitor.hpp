@@ -18,6 +18,8 @@ struct numeric_visitor : ::boost::static_visitor<bool> {
   bool operator()(From) const;
   bool operator()(const std::string&) const;
   bool operator()(const blob_t&) const  { return false; }
+  bool operator()(const string_view& from) const  { return operator()(from.to_string()); }
+  bool operator()(const blob_view&) const  { return false; }
 }; // numeric_visitor
 
 template <typename To>
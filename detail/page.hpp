@@ -4,30 +4,41 @@
 #define BRIG_DETAIL_PAGE_HPP
 
 #include <algorithm>
-#include <array>
 #include <boost/utility.hpp>
+#include <brig/detail/arena.hpp>
+#include <brig/detail/bytes_of.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/global.hpp>
 #include <brig/rowset.hpp>
 #include <brig/variant.hpp>
+#include <cstring>
 #include <vector>
 
 namespace brig { namespace detail {
 
+/*!
+borrowed strings and blobs are copied into the page arena on fill, so rows hold views which expire on clear()\n
+fill() stops at max_rows or after max_bytes of values, but a page takes at least one row\n
+*/
 class page : ::boost::noncopyable { // ::boost::circular_buffer is slow
-  std::array<std::vector<variant>, PageSize + 1> m_rows;
-  size_t m_beg, m_end;
+  std::vector<std::vector<variant>> m_rows;
+  size_t m_beg, m_end, m_bytes, m_max_bytes;
+  arena m_arena;
 
-  static size_t next(size_t pos)  { return pos < PageSize? pos + 1: 0; }
+  size_t next(size_t pos) const  { return pos + 1 < m_rows.size()? pos + 1: 0; }
+  void keep(variant& var);
+  static void pass(variant& from, variant& to, bool view);
 
 public:
-  page() : m_beg(0), m_end(0)  {}
+  explicit page(size_t max_rows = PageRows, size_t max_bytes = PageBytes) : m_rows(std::max<>(max_rows, size_t(1)) + 1), m_beg(0), m_end(0), m_bytes(0), m_max_bytes(max_bytes)  {}
   void swap(page& r);
-  bool full() const  { return m_beg == next(m_end); }
+  size_t bytes() const  { return m_bytes; }
 
-  void clear()  { m_beg = m_end = 0; }
+  void clear()  { m_beg = m_end = m_bytes = 0; m_arena.clear(); }
   bool empty() const  { return m_beg == m_end; }
   bool fetch(std::vector<variant>& row);
-  void fill(rowset* rs);
+  bool fetch_view(std::vector<variant>& row);
+  bool fill(rowset* rs); // @return false at the end of the rowset
 }; // page
 
 inline void page::swap(page& r)
@@ -35,22 +46,79 @@ inline void page::swap(page& r)
   m_rows.swap(r.m_rows);
   std::swap(m_beg, r.m_beg);
   std::swap(m_end, r.m_end);
+  std::swap(m_bytes, r.m_bytes);
+  std::swap(m_max_bytes, r.m_max_bytes);
+  m_arena.swap(r.m_arena);
+}
+
+inline void page::keep(variant& var)
+{
+  if (typeid(string_view) == var.type())
+  {
+    const string_view& str(::boost::get<string_view>(var));
+    char* ptr((char*)m_arena.allocate(str.size()));
+    memcpy(ptr, str.data(), str.size());
+    var = string_view(ptr, str.size());
+  }
+  else if (typeid(blob_view) == var.type())
+  {
+    const blob_view& blob(::boost::get<blob_view>(var));
+    void* ptr(m_arena.allocate(blob.size()));
+    memcpy(ptr, blob.data(), blob.size());
+    var = blob_view(ptr, blob.size());
+  }
+}
+
+inline void page::pass(variant& from, variant& to, bool view)
+{
+  if (!view && typeid(string_view) == from.type())
+  {
+    const string_view& str(::boost::get<string_view>(from));
+    recycle<std::string>(to).assign(str.begin(), str.end());
+  }
+  else if (!view && typeid(blob_view) == from.type())
+  {
+    const blob_view& blob(::boost::get<blob_view>(from));
+    recycle<blob_t>(to).assign(blob.begin(), blob.end());
+  }
+  else if (typeid(std::string) == from.type() || typeid(blob_t) == from.type())
+    to.swap(from); // previous buffer is returned to the page for reuse
+  else
+    to = from;
 }
 
 inline bool page::fetch(std::vector<variant>& row)
 {
   if (m_beg == m_end) return false;
-  row.swap(m_rows[m_beg]);
+  std::vector<variant>& from(m_rows[m_beg]);
+  row.resize(from.size());
+  for (size_t i(0); i < from.size(); ++i) pass(from[i], row[i], false);
+  m_beg = next(m_beg);
+  return true;
+}
+
+inline bool page::fetch_view(std::vector<variant>& row)
+{
+  if (m_beg == m_end) return false;
+  std::vector<variant>& from(m_rows[m_beg]);
+  row.resize(from.size());
+  for (size_t i(0); i < from.size(); ++i) pass(from[i], row[i], true);
   m_beg = next(m_beg);
   return true;
 }
 
-inline void page::fill(rowset* rs)
+inline bool page::fill(rowset* rs)
 {
   while (true)
   {
     const size_t end(next(m_end));
-    if (m_beg == end || !rs || !rs->fetch(m_rows[m_end])) return;
+    if (m_beg == end || (!empty() && m_bytes >= m_max_bytes)) return true;
+    if (!rs || !rs->fetch_view(m_rows[m_end])) return false;
+    for (auto& var: m_rows[m_end])
+    {
+      keep(var);
+      m_bytes += bytes_of(var);
+    }
     m_end = end;
   }
 } // page::
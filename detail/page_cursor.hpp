@@ -0,0 +1,92 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_PAGE_CURSOR_HPP
+#define BRIG_DETAIL_PAGE_CURSOR_HPP
+
+#include <boost/utility.hpp>
+#include <brig/blob_t.hpp>
+#include <brig/blob_view.hpp>
+#include <brig/rowset.hpp>
+#include <brig/string_view.hpp>
+#include <brig/variant.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace brig { namespace detail {
+
+typedef std::vector<std::vector<variant>> row_page; // values keep their types, unlike column_batch
+
+inline size_t read_page(rowset& rs, row_page& page, size_t max_rows)
+{
+  std::vector<variant> row;
+  page.clear();
+  while (page.size() < max_rows && rs.fetch(row))
+  {
+    page.push_back(std::vector<variant>());
+    std::swap(page.back(), row);
+  }
+  return page.size();
+}
+
+/*!
+reading position in a page of rows, the page is owned by the cursor or shared:\n
+* rows of an owned page are moved out by fetch() without views\n
+* views refer to the page, so they are valid until the cursor is reset\n
+*/
+class page_cursor : ::boost::noncopyable {
+  row_page m_own;
+  std::shared_ptr<const row_page> m_shared;
+  const row_page* m_page;
+  size_t m_row;
+
+  static variant view_of(const variant& val);
+
+public:
+  page_cursor() : m_page(0), m_row(0)  {}
+  bool empty() const  { return !m_page || m_row >= m_page->size(); }
+  void reset(row_page& page); // page is swapped in
+  void reset(std::shared_ptr<const row_page> page);
+  void fetch(std::vector<variant>& row, bool view);
+}; // page_cursor
+
+inline variant page_cursor::view_of(const variant& val)
+{
+  if (const std::string* str = ::boost::get<std::string>(&val)) return string_view(*str);
+  if (const blob_t* blob = ::boost::get<blob_t>(&val)) return blob_view(*blob);
+  return val;
+}
+
+inline void page_cursor::reset(row_page& page)
+{
+  std::swap(m_own, page);
+  m_shared.reset();
+  m_page = &m_own;
+  m_row = 0;
+}
+
+inline void page_cursor::reset(std::shared_ptr<const row_page> page)
+{
+  m_own.clear();
+  m_shared = page;
+  m_page = m_shared.get();
+  m_row = 0;
+}
+
+inline void page_cursor::fetch(std::vector<variant>& row, bool view)
+{
+  const std::vector<variant>& src((*m_page)[m_row]);
+  if (view)
+  {
+    row.resize(src.size());
+    for (size_t i(0); i < src.size(); ++i) row[i] = view_of(src[i]);
+  }
+  else if (m_shared) row = src;
+  else std::swap(row, m_own[m_row]);
+  ++m_row;
+} // page_cursor::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_PAGE_CURSOR_HPP
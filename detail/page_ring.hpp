@@ -0,0 +1,178 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_PAGE_RING_HPP
+#define BRIG_DETAIL_PAGE_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <boost/utility.hpp>
+#include <brig/detail/byte_budget.hpp>
+#include <brig/detail/page.hpp>
+#include <brig/rowset.hpp>
+#include <brig/variant.hpp>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace brig { namespace detail {
+
+/*!
+single-producer / single-consumer ring of pages:\n
+* the producer (worker thread) fills pages ahead while the ring is not full and the budget is available, see ready() and fill()\n
+* the consumer blocks only if the ring is empty\n
+* the consumer wakes the producer when it releases a page and the producer is stalled\n
+* reset() must be called by the producer while the consumer waits (i.e. within mediator call)\n
+*/
+class page_ring : ::boost::noncopyable {
+  std::vector<std::unique_ptr<page>> m_pages;
+  std::atomic<size_t> m_head, m_tail; // counters of produced / consumed pages
+  std::atomic<bool> m_active, m_done, m_waiting, m_stalled;
+  std::shared_ptr<byte_budget> m_budget; // optional
+  std::exception_ptr m_exc; // published by m_done
+  page* m_cur; // consumer
+  std::function<void()> m_wake; // producer is parked while the ring is inactive, full or out of budget
+  std::mutex m_mut;
+  std::condition_variable m_cond;
+
+  void publish(bool page);
+  bool can_fill() const;
+  void release(size_t tail); // consumer
+  page* front(); // consumer
+
+public:
+  page_ring(size_t pages, std::shared_ptr<byte_budget> budget, std::function<void()> wake);
+  ~page_ring()  { reset(); }
+
+  // producer
+  void reset();
+  bool ready(); // otherwise the producer is stalled until the consumer wakes it
+  void fill(rowset* rs);
+
+  // consumer
+  bool fetch(std::vector<variant>& row);
+  bool fetch_view(std::vector<variant>& row);
+}; // page_ring
+
+inline page_ring::page_ring(size_t pages, std::shared_ptr<byte_budget> budget, std::function<void()> wake)
+  : m_head(0), m_tail(0), m_active(false), m_done(false), m_waiting(false), m_stalled(false), m_budget(budget), m_cur(0), m_wake(wake)
+{
+  for (size_t i(0), count(std::max<>(pages, size_t(1))); i < count; ++i)
+    m_pages.push_back(std::unique_ptr<page>(new page()));
+}
+
+inline void page_ring::reset()
+{
+  if (m_budget)
+    for (size_t i(m_tail); i < m_head; ++i)
+      m_budget->release(m_pages[i % m_pages.size()]->bytes());
+  m_head = 0;
+  m_tail = 0;
+  m_active = false;
+  m_done = false;
+  m_exc = std::exception_ptr();
+  m_cur = 0;
+}
+
+inline void page_ring::publish(bool page)
+{
+  if (page) ++m_head; else m_done = true;
+  if (m_waiting)
+  {
+    std::lock_guard<std::mutex> lock(m_mut);
+    m_cond.notify_one();
+  }
+}
+
+inline bool page_ring::can_fill() const
+{
+  if (!m_active || m_done) return false;
+  const size_t used(m_head - m_tail);
+  return used == 0 || (used < m_pages.size() && (!m_budget || m_budget->available()));
+}
+
+inline bool page_ring::ready()
+{
+  if (can_fill()) return true;
+  m_stalled = true;
+  return can_fill(); // the consumer might have released a page before m_stalled
+}
+
+inline void page_ring::fill(rowset* rs)
+{
+  if (!can_fill()) return;
+  page& pg(*m_pages[m_head % m_pages.size()]);
+  pg.clear();
+  try
+  {
+    const bool more(pg.fill(rs));
+    if (m_budget) m_budget->acquire(pg.bytes());
+    if (!pg.empty()) publish(true);
+    if (!more) publish(false);
+  }
+  catch (const std::exception&)
+  {
+    pg.clear();
+    m_exc = std::current_exception();
+    publish(false);
+  }
+}
+
+inline void page_ring::release(size_t tail)
+{
+  if (m_budget) m_budget->release(m_cur->bytes());
+  m_cur = 0;
+  m_tail = tail + 1;
+  if (m_stalled.exchange(false)) m_wake();
+}
+
+inline page* page_ring::front()
+{
+  if (!m_active.exchange(true)) m_wake(); // prefetch starts with the first fetch
+  while (true)
+  {
+    const size_t tail(m_tail);
+    if (m_cur)
+    {
+      if (!m_cur->empty()) return m_cur;
+      release(tail);
+      continue;
+    }
+    if (tail == m_head && !m_done)
+    {
+      std::unique_lock<std::mutex> lock(m_mut);
+      m_waiting = true;
+      m_cond.wait(lock, [&](){ return tail != this->m_head || this->m_done; });
+      m_waiting = false;
+    }
+    if (tail != m_head)
+    {
+      m_cur = m_pages[tail % m_pages.size()].get();
+      continue;
+    }
+    if (!(m_exc == 0))
+    {
+      std::exception_ptr exc; std::swap(exc, m_exc);
+      std::rethrow_exception(exc);
+    }
+    return 0;
+  }
+}
+
+inline bool page_ring::fetch(std::vector<variant>& row)
+{
+  page* pg(front());
+  return pg && pg->fetch(row);
+}
+
+inline bool page_ring::fetch_view(std::vector<variant>& row)
+{
+  page* pg(front());
+  return pg && pg->fetch_view(row);
+} // page_ring::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_PAGE_RING_HPP
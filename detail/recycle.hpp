@@ -0,0 +1,24 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_RECYCLE_HPP
+#define BRIG_DETAIL_RECYCLE_HPP
+
+#include <brig/variant.hpp>
+
+namespace brig { namespace detail {
+
+/*!
+@return the alternative of type T, capacity of the previous value is kept if it was T
+*/
+template <typename T>
+T& recycle(variant& var)
+{
+  T* ptr(::boost::get<T>(&var));
+  if (ptr) return *ptr;
+  var = T();
+  return ::boost::get<T>(var);
+}
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_RECYCLE_HPP
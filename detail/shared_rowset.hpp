@@ -0,0 +1,72 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_SHARED_ROWSET_HPP
+#define BRIG_DETAIL_SHARED_ROWSET_HPP
+
+#include <brig/detail/page_cursor.hpp>
+#include <brig/global.hpp>
+#include <brig/rowset.hpp>
+#include <brig/variant.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace brig { namespace detail {
+
+struct shared_result {
+  std::vector<std::string> columns;
+  std::vector<row_page> pages;
+}; // shared_result
+
+inline std::shared_ptr<const shared_result> materialize(rowset& rs)
+{
+  auto res(std::make_shared<shared_result>());
+  res->columns = rs.columns();
+  row_page page;
+  while (read_page(rs, page, PageRows) > 0)
+  {
+    res->pages.push_back(row_page());
+    std::swap(res->pages.back(), page);
+  }
+  return res;
+}
+
+/*!
+reader of the result shared by many rowsets, values keep the types of the source rowset
+*/
+class shared_rowset : public rowset {
+  std::shared_ptr<const shared_result> m_res;
+  size_t m_page; // next
+  page_cursor m_cur;
+
+  bool ready();
+  bool fetch(std::vector<variant>& row, bool view);
+
+public:
+  explicit shared_rowset(std::shared_ptr<const shared_result> res) : m_res(res), m_page(0)  {}
+  std::vector<std::string> columns() override  { return m_res->columns; }
+  bool fetch(std::vector<variant>& row) override  { return fetch(row, false); }
+  bool fetch_view(std::vector<variant>& row) override  { return fetch(row, true); }
+}; // shared_rowset
+
+inline bool shared_rowset::ready()
+{
+  while (m_cur.empty())
+  {
+    if (m_page >= m_res->pages.size()) return false;
+    m_cur.reset(std::shared_ptr<const row_page>(m_res, &m_res->pages[m_page++])); // aliasing, the result keeps the page
+  }
+  return true;
+}
+
+inline bool shared_rowset::fetch(std::vector<variant>& row, bool view)
+{
+  if (!ready()) return false;
+  m_cur.fetch(row, view);
+  return true;
+} // shared_rowset::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_SHARED_ROWSET_HPP
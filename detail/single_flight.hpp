@@ -0,0 +1,61 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_SINGLE_FLIGHT_HPP
+#define BRIG_DETAIL_SINGLE_FLIGHT_HPP
+
+#include <boost/utility.hpp>
+#include <exception>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace brig { namespace detail {
+
+/*!
+concurrent calls with the same key share one execution:\n
+* the first caller runs the function, others wait for its result or exception\n
+* the key is released when the call completes, later calls run again\n
+*/
+template <typename T>
+class single_flight : ::boost::noncopyable {
+  std::mutex m_mut;
+  std::map<std::string, std::shared_future<T>> m_calls;
+public:
+  template <typename Fn> T run(const std::string& key, Fn fn);
+}; // single_flight
+
+template <typename T>
+template <typename Fn>
+T single_flight<T>::run(const std::string& key, Fn fn)
+{
+  using namespace std;
+
+  promise<T> prom;
+  shared_future<T> fut;
+  bool leader(false);
+  {
+    lock_guard<mutex> lck(m_mut);
+    auto iter(m_calls.find(key));
+    if (iter != m_calls.end()) fut = iter->second;
+    else
+    {
+      fut = prom.get_future().share();
+      m_calls[key] = fut;
+      leader = true;
+    }
+  }
+  if (!leader) return fut.get();
+
+  try  { prom.set_value(fn()); }
+  catch (...)  { prom.set_exception(current_exception()); }
+  {
+    lock_guard<mutex> lck(m_mut);
+    m_calls.erase(key);
+  }
+  return fut.get();
+} // single_flight::
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_SINGLE_FLIGHT_HPP
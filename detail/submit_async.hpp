@@ -0,0 +1,31 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_SUBMIT_ASYNC_HPP
+#define BRIG_DETAIL_SUBMIT_ASYNC_HPP
+
+#include <brig/executor.hpp>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace brig { namespace detail {
+
+/*!
+executor of blocking provider calls, it is separate from executor::singleton()
+because the calls wait for threaded commands and rowsets whose workers run there
+*/
+inline executor& async_executor()  { static executor s; return s; }
+
+template <typename Fn>
+std::future<typename std::result_of<Fn()>::type> submit_async(Fn fn)
+{
+  typedef typename std::result_of<Fn()>::type result_type;
+  auto task(std::make_shared<std::packaged_task<result_type()>>(fn));
+  auto res(task->get_future());
+  async_executor().submit([task]()  { (*task)(); });
+  return res;
+}
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_SUBMIT_ASYNC_HPP
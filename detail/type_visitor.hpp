@@ -0,0 +1,28 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_TYPE_VISITOR_HPP
+#define BRIG_DETAIL_TYPE_VISITOR_HPP
+
+#include <brig/column_type.hpp>
+#include <brig/variant.hpp>
+#include <cstdint>
+#include <string>
+
+namespace brig { namespace detail {
+
+struct type_visitor : ::boost::static_visitor<column_type> {
+  column_type operator()(const null_t&) const  { return column_type::Void; }
+  column_type operator()(int16_t) const  { return column_type::Integer; }
+  column_type operator()(int32_t) const  { return column_type::Integer; }
+  column_type operator()(int64_t) const  { return column_type::Integer; }
+  column_type operator()(float) const  { return column_type::Double; }
+  column_type operator()(double) const  { return column_type::Double; }
+  column_type operator()(const std::string&) const  { return column_type::String; }
+  column_type operator()(const blob_t&) const  { return column_type::Blob; }
+  column_type operator()(const string_view&) const  { return column_type::String; }
+  column_type operator()(const blob_view&) const  { return column_type::Blob; }
+}; // type_visitor
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_TYPE_VISITOR_HPP
@@ -0,0 +1,76 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_DETAIL_TYPED_VALUE_HPP
+#define BRIG_DETAIL_TYPED_VALUE_HPP
+
+#include <boost/mpl/size.hpp>
+#include <brig/blob_t.hpp>
+#include <brig/detail/numeric_visitor.hpp>
+#include <brig/string_cast.hpp>
+#include <brig/variant.hpp>
+#include <string>
+#include <type_traits>
+
+namespace brig { namespace detail {
+
+template <typename T, bool Arithmetic = std::is_arithmetic<T>::value>
+struct typed_value;
+
+template <typename T>
+struct typed_value<T, true> {
+  static bool assign(const null_t&, T& to)  { to = T(); return true; }
+  template <typename From>
+  static bool assign(const From& from, T& to)  { return numeric_visitor<T>(to)(from); }
+}; // typed_value<T, true>
+
+template <>
+struct typed_value<std::string, false> {
+  static bool assign(const null_t&, std::string& to)  { to.clear(); return true; }
+  static bool assign(const std::string& from, std::string& to)  { to.assign(from); return true; }
+  static bool assign(const string_view& from, std::string& to)  { to.assign(from.data(), from.size()); return true; }
+  static bool assign(const blob_t&, std::string&)  { return false; }
+  static bool assign(const blob_view&, std::string&)  { return false; }
+  template <typename From>
+  static bool assign(const From& from, std::string& to)  { to = string_cast<char>(from); return true; }
+}; // typed_value<std::string, false>
+
+template <>
+struct typed_value<blob_t, false> {
+  static bool assign(const null_t&, blob_t& to)  { to.clear(); return true; }
+  static bool assign(const blob_t& from, blob_t& to)  { to.assign(from.begin(), from.end()); return true; }
+  static bool assign(const blob_view& from, blob_t& to)  { to.assign(from.begin(), from.end()); return true; }
+  template <typename From>
+  static bool assign(const From&, blob_t&)  { return false; }
+}; // typed_value<blob_t, false>
+
+typedef bool (*typed_decoder)(const variant& var, void* to);
+
+template <typename T, typename From>
+bool typed_decode(const variant& var, void* to)
+{
+  return typed_value<T>::assign(*::boost::get<From>(&var), *static_cast<T*>(to));
+}
+
+/** @return decoder of the variant alternative (which) into T */
+template <typename T>
+typed_decoder get_typed_decoder(int which)
+{
+  static_assert(::boost::mpl::size<variant::types>::value == 10, "variant error");
+  static const typed_decoder decoders[] =
+    { &typed_decode<T, null_t>
+    , &typed_decode<T, int16_t>
+    , &typed_decode<T, int32_t>
+    , &typed_decode<T, int64_t>
+    , &typed_decode<T, float>
+    , &typed_decode<T, double>
+    , &typed_decode<T, std::string>
+    , &typed_decode<T, blob_t>
+    , &typed_decode<T, string_view>
+    , &typed_decode<T, blob_view>
+    };
+  return decoders[which];
+}
+
+} } // brig::detail
+
+#endif // BRIG_DETAIL_TYPED_VALUE_HPP
@@ -0,0 +1,168 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_EXECUTOR_HPP
+#define BRIG_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <boost/utility.hpp>
+#include <brig/global.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+  #include <windows.h>
+#elif defined __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+namespace brig {
+
+/*!
+work-stealing thread pool:\n
+* every thread owns a deque, it pops the newest task and steals the oldest ones from the others\n
+* threads are optionally bound to CPUs (round-robin on cpus)\n
+* tasks should not wait for other tasks of the same executor\n
+* the destructor runs the queued tasks and joins the threads\n
+*/
+class executor : ::boost::noncopyable {
+  struct queue  { std::mutex mut; std::deque<std::function<void()>> tasks; };
+
+  std::vector<std::unique_ptr<queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::vector<std::thread::id> m_ids;
+  std::atomic<size_t> m_next, m_pending, m_parked;
+  std::atomic<bool> m_stop;
+  std::mutex m_mut;
+  std::condition_variable m_cond;
+
+  size_t index() const; // of the current thread, size() if outsider
+  bool pop(size_t i, std::function<void()>& task);
+  bool steal(size_t i, std::function<void()>& task);
+  void work(size_t i);
+  static void set_affinity(std::thread& t, int cpu);
+
+public:
+  explicit executor(size_t threads = std::max<>(ExecutorSize, size_t(std::thread::hardware_concurrency())), const std::vector<int>& cpus = std::vector<int>());
+  ~executor();
+  size_t size() const  { return m_threads.size(); }
+  void submit(std::function<void()> task);
+  static executor& singleton()  { static executor s; return s; }
+}; // executor
+
+inline executor::executor(size_t threads, const std::vector<int>& cpus) : m_next(0), m_pending(0), m_parked(0), m_stop(false)
+{
+  threads = std::max<>(threads, size_t(1));
+  for (size_t i(0); i < threads; ++i) m_queues.push_back(std::unique_ptr<queue>(new queue()));
+  std::unique_lock<std::mutex> lock(m_mut); // m_ids
+  for (size_t i(0); i < threads; ++i)
+  {
+    m_threads.push_back(std::thread(&executor::work, this, i));
+    m_ids.push_back(m_threads.back().get_id());
+    if (!cpus.empty()) set_affinity(m_threads.back(), cpus[i % cpus.size()]);
+  }
+}
+
+inline executor::~executor()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mut);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  for (auto& t: m_threads) t.join();
+}
+
+inline void executor::set_affinity(std::thread& t, int cpu)
+{
+#ifdef _MSC_VER
+  SetThreadAffinityMask(t.native_handle(), DWORD_PTR(1) << cpu);
+#elif defined __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+  (void)t; (void)cpu;
+#endif
+}
+
+inline size_t executor::index() const
+{
+  const auto id(std::this_thread::get_id());
+  return size_t(std::find(m_ids.begin(), m_ids.end(), id) - m_ids.begin());
+}
+
+inline void executor::submit(std::function<void()> task)
+{
+  size_t i(index());
+  if (i >= m_queues.size()) i = m_next++ % m_queues.size();
+  {
+    std::lock_guard<std::mutex> lock(m_queues[i]->mut);
+    m_queues[i]->tasks.push_back(std::move(task));
+  }
+  ++m_pending;
+  if (m_parked > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mut);
+    m_cond.notify_one();
+  }
+}
+
+inline bool executor::pop(size_t i, std::function<void()>& task)
+{
+  std::lock_guard<std::mutex> lock(m_queues[i]->mut);
+  if (m_queues[i]->tasks.empty()) return false;
+  task = std::move(m_queues[i]->tasks.back());
+  m_queues[i]->tasks.pop_back();
+  return true;
+}
+
+inline bool executor::steal(size_t i, std::function<void()>& task)
+{
+  for (size_t j(1); j < m_queues.size(); ++j)
+  {
+    queue& q(*m_queues[(i + j) % m_queues.size()]);
+    std::lock_guard<std::mutex> lock(q.mut);
+    if (q.tasks.empty()) continue;
+    task = std::move(q.tasks.front());
+    q.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+inline void executor::work(size_t i)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mut); // wait for m_ids
+  }
+  while (true)
+  {
+    std::function<void()> task;
+    if (pop(i, task) || steal(i, task))
+    {
+      --m_pending;
+      try  { task(); }
+      catch (const std::exception&)  {}
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mut);
+    ++m_parked;
+    m_cond.wait(lock, [&](){ return this->m_pending > 0 || this->m_stop; });
+    --m_parked;
+    if (m_stop && m_pending == 0) return;
+  }
+} // executor::
+
+} // brig
+
+#endif // BRIG_EXECUTOR_HPP
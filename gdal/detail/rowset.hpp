@@ -10,6 +10,7 @@
 #include <brig/boost/geom_from_wkb.hpp>
 #include <brig/boost/geometry.hpp>
 #include <brig/detail/get_columns.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/gdal/detail/dataset_allocator.hpp>
 #include <brig/gdal/detail/lib.hpp>
 #include <brig/gdal/detail/transform.hpp>
@@ -106,8 +107,7 @@ inline bool rowset::fetch(std::vector<variant>& row)
         vsi_l_offset len(0);
         auto del = [](void* ptr) { lib::singleton().p_VSIFree(ptr); };
         unique_ptr<void, decltype(del)> buf(lib::singleton().p_VSIGetMemFileBuffer(file.c_str(), &len, true), del);
-        row[i] = blob_t();
-        blob_t& blob = ::boost::get<blob_t>(row[i]);
+        blob_t& blob = brig::detail::recycle<blob_t>(row[i]);
         const uint8_t* ptr(static_cast<const uint8_t*>(buf.get()));
         blob.assign(ptr, ptr + size_t(len));
       }
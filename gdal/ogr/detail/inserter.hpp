@@ -3,11 +3,12 @@
 #ifndef BRIG_GDAL_OGR_DETAIL_INSERTER_HPP
 #define BRIG_GDAL_OGR_DETAIL_INSERTER_HPP
 
+#include <boost/mpl/size.hpp>
 #include <brig/detail/get_columns.hpp>
+#include <brig/detail/numeric_visitor.hpp>
 #include <brig/gdal/detail/lib.hpp>
 #include <brig/gdal/ogr/detail/datasource_allocator.hpp>
 #include <brig/inserter.hpp>
-#include <brig/numeric_cast.hpp>
 #include <brig/table_def.hpp>
 #include <iterator>
 #include <stdexcept>
@@ -22,6 +23,19 @@ class inserter : public brig::inserter {
   OGRFeatureDefnH m_feature_def;
   OGRSpatialReferenceH m_sr;
   std::vector<int> m_fields;
+
+  typedef void (*set_field)(OGRFeatureH feature, int field, const variant& var);
+  static set_field get_setter(int which); // of the variant alternative
+  static void set_null(OGRFeatureH feature, int field, const variant& var);
+  template <typename T>
+  static void set_integer(OGRFeatureH feature, int field, const variant& var);
+  template <typename T>
+  static void set_double(OGRFeatureH feature, int field, const variant& var);
+  static void set_string(OGRFeatureH feature, int field, const variant& var);
+  static void set_string_view(OGRFeatureH feature, int field, const variant& var);
+  static void set_blob(OGRFeatureH feature, int field, const variant& var);
+  static void set_blob_view(OGRFeatureH feature, int field, const variant& var);
+
 public:
   inserter(datasource_allocator allocator, const table_def& tbl);
   void insert(std::vector<variant>& row) override;
@@ -53,6 +67,65 @@ inline inserter::inserter(datasource_allocator allocator, const table_def& tbl)
   }
 }
 
+inline inserter::set_field inserter::get_setter(int which)
+{
+  static_assert(::boost::mpl::size<variant::types>::value == 10, "variant error");
+  static const set_field setters[] =
+    { &inserter::set_null
+    , &inserter::set_integer<int16_t>
+    , &inserter::set_integer<int32_t>
+    , &inserter::set_integer<int64_t>
+    , &inserter::set_double<float>
+    , &inserter::set_double<double>
+    , &inserter::set_string
+    , &inserter::set_blob
+    , &inserter::set_string_view
+    , &inserter::set_blob_view
+    };
+  return setters[which];
+}
+
+inline void inserter::set_null(OGRFeatureH feature, int field, const variant&)
+{
+  gdal::detail::lib::singleton().p_OGR_F_UnsetField(feature, field);
+}
+
+template <typename T>
+void inserter::set_integer(OGRFeatureH feature, int field, const variant& var)
+{
+  int val(0);
+  if (!brig::detail::numeric_visitor<int>(val)(*::boost::get<T>(&var))) throw std::runtime_error("OGR error");
+  gdal::detail::lib::singleton().p_OGR_F_SetFieldInteger(feature, field, val);
+}
+
+template <typename T>
+void inserter::set_double(OGRFeatureH feature, int field, const variant& var)
+{
+  gdal::detail::lib::singleton().p_OGR_F_SetFieldDouble(feature, field, double(*::boost::get<T>(&var)));
+}
+
+inline void inserter::set_string(OGRFeatureH feature, int field, const variant& var)
+{
+  gdal::detail::lib::singleton().p_OGR_F_SetFieldString(feature, field, ::boost::get<std::string>(&var)->c_str());
+}
+
+inline void inserter::set_string_view(OGRFeatureH feature, int field, const variant& var)
+{
+  gdal::detail::lib::singleton().p_OGR_F_SetFieldString(feature, field, ::boost::get<string_view>(&var)->to_string().c_str());
+}
+
+inline void inserter::set_blob(OGRFeatureH feature, int field, const variant& var)
+{
+  const blob_t& blob(*::boost::get<blob_t>(&var));
+  gdal::detail::lib::singleton().p_OGR_F_SetFieldBinary(feature, field, int(blob.size()), (GByte*)blob.data());
+}
+
+inline void inserter::set_blob_view(OGRFeatureH feature, int field, const variant& var)
+{
+  const blob_view& blob(*::boost::get<blob_view>(&var));
+  gdal::detail::lib::singleton().p_OGR_F_SetFieldBinary(feature, field, int(blob.size()), (GByte*)blob.data());
+}
+
 inline void inserter::insert(std::vector<variant>& row)
 {
   using namespace std;
@@ -67,37 +140,13 @@ inline void inserter::insert(std::vector<variant>& row)
   {
     if (m_fields[i] < 0)
     {
-      blob_t& wkb(::boost::get<blob_t>(row[i]));
+      const blob_view wkb(typeid(blob_view) == row[i].type()? ::boost::get<blob_view>(row[i]): blob_view(::boost::get<blob_t>(row[i])));
       OGRGeometryH geom(0);
       lib::check(lib::singleton().p_OGR_G_CreateFromWkb((unsigned char*)wkb.data(), m_sr, &geom, int(wkb.size())));
       lib::singleton().p_OGR_F_SetGeometryDirectly(feature.get(), geom);
     }
-    else if (typeid(null_t) == row[i].type())
-      lib::singleton().p_OGR_F_UnsetField(feature.get(), m_fields[i]);
-    else if (typeid(int16_t) == row[i].type() || typeid(int32_t) == row[i].type() || typeid(int64_t) == row[i].type())
-    {
-      int val(0);
-      if (!numeric_cast(row[i], val)) throw runtime_error("OGR error");
-      lib::singleton().p_OGR_F_SetFieldInteger(feature.get(), m_fields[i], val);
-    }
-    else if (typeid(float) == row[i].type() || typeid(double) == row[i].type())
-    {
-      double val(0);
-      if (!numeric_cast(row[i], val)) throw runtime_error("OGR error");
-      lib::singleton().p_OGR_F_SetFieldDouble(feature.get(), m_fields[i], val);
-    }
-    else if (typeid(string) == row[i].type())
-    {
-      string& str(::boost::get<string>(row[i]));
-      lib::singleton().p_OGR_F_SetFieldString(feature.get(), m_fields[i], str.c_str());
-    }
-    else if (typeid(blob_t) == row[i].type())
-    {
-      blob_t& blob(::boost::get<blob_t>(row[i]));
-      lib::singleton().p_OGR_F_SetFieldBinary(feature.get(), m_fields[i], int(blob.size()), (GByte*)blob.data());
-    }
     else
-      throw runtime_error("OGR error");
+      get_setter(row[i].which())(feature.get(), m_fields[i], row[i]);
   }
 
   lib::check(lib::singleton().p_OGR_L_CreateFeature(m_lr, feature.get()));
@@ -7,6 +7,7 @@
 #include <brig/boost/geom_from_wkb.hpp>
 #include <brig/boost/geometry.hpp>
 #include <brig/detail/get_columns.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/gdal/detail/lib.hpp>
 #include <brig/gdal/ogr/detail/datasource_allocator.hpp>
 #include <brig/global.hpp>
@@ -24,15 +25,19 @@ class rowset : public brig::rowset {
   OGRLayerH m_lr;
   std::vector<int> m_cols;
   int m_rows;
+  std::shared_ptr<void> m_feature; // owns viewed values
+  std::vector<blob_t> m_wkbs;
 
   int m_interleaved_reading_lr;
   bool m_interleaved_reading_non_empty;
   std::shared_ptr<void> interleaved_reading_next();
+  bool fetch(std::vector<variant>& row, bool view);
 
 public:
   rowset(datasource_allocator allocator, const table_def& tbl);
   std::vector<std::string> columns() override;
-  bool fetch(std::vector<variant>& row) override;
+  bool fetch(std::vector<variant>& row) override  { return fetch(row, false); }
+  bool fetch_view(std::vector<variant>& row) override  { return fetch(row, true); }
 }; // rowset
 
 inline rowset::rowset(datasource_allocator allocator, const table_def& tbl)
@@ -59,6 +64,7 @@ inline rowset::rowset(datasource_allocator allocator, const table_def& tbl)
     }
   }
   m_rows = tbl.query_rows;
+  m_wkbs.resize(m_cols.size());
 
   string attribute_filter;
   for (const auto& col: tbl.columns)
@@ -139,11 +145,12 @@ std::shared_ptr<void> rowset::interleaved_reading_next()
   }
 }
 
-inline bool rowset::fetch(std::vector<variant>& row)
+inline bool rowset::fetch(std::vector<variant>& row, bool view)
 {
   using namespace std;
   using namespace gdal::detail;
 
+  m_feature.reset();
   if (!m_lr || m_rows == 0) return false;
   if (m_rows > 0) --m_rows;
   auto feature(interleaved_reading_next());
@@ -157,10 +164,10 @@ inline bool rowset::fetch(std::vector<variant>& row)
       int size(geom? lib::singleton().p_OGR_G_WkbSize(geom): 0);
       if (size > 0)
       {
-        row[i] = blob_t();
-        blob_t& blob = ::boost::get<blob_t>(row[i]);
+        blob_t& blob = view? m_wkbs[i]: brig::detail::recycle<blob_t>(row[i]);
         blob.resize(size_t(size));
         lib::singleton().p_OGR_G_ExportToWkb(geom, wkbXDR, (unsigned char*)blob.data());
+        if (view) row[i] = blob_view(blob);
       }
       else
         row[i] = null_t();
@@ -176,16 +183,20 @@ inline bool rowset::fetch(std::vector<variant>& row)
       case OFTReal: row[i] = lib::singleton().p_OGR_F_GetFieldAsDouble(feature.get(), m_cols[i]); break;
       case OFTDate:
       case OFTTime:
-      case OFTDateTime:
-      case OFTString: row[i] = string(lib::singleton().p_OGR_F_GetFieldAsString(feature.get(), m_cols[i])); break;
+      case OFTDateTime: brig::detail::recycle<string>(row[i]) = lib::singleton().p_OGR_F_GetFieldAsString(feature.get(), m_cols[i]); break; // formatted into a shared buffer
+      case OFTString:
+        if (view) row[i] = string_view(lib::singleton().p_OGR_F_GetFieldAsString(feature.get(), m_cols[i]));
+        else brig::detail::recycle<string>(row[i]) = lib::singleton().p_OGR_F_GetFieldAsString(feature.get(), m_cols[i]);
+        break;
       case OFTBinary:
         {
         int size(0);
         GByte* bytes(lib::singleton().p_OGR_F_GetFieldAsBinary(feature.get(), m_cols[i], &size));
-        if (size > 0)
+        if (size > 0 && view)
+          row[i] = blob_view(bytes, size_t(size));
+        else if (size > 0)
         {
-          row[i] = blob_t();
-          blob_t& blob = ::boost::get<blob_t>(row[i]);
+          blob_t& blob = brig::detail::recycle<blob_t>(row[i]);
           blob.resize(size_t(size));
           memcpy((GByte*)blob.data(), bytes, size_t(size));
         }
@@ -196,6 +207,7 @@ inline bool rowset::fetch(std::vector<variant>& row)
       }
     }
   }
+  if (view) m_feature = feature;
   return true;
 } // rowset::
 
@@ -9,7 +9,26 @@ const char LibVersion[] = "1306+";
 
 const int CharsLimit = 250;
 const size_t PageSize = 250; // DB2 PUERTO_ROADS is slowdown after 447
-const size_t PoolSize = 4;
+const size_t FetchSizeMin = 16; // rows per round trip, see database::detail::fetch_sizer
+const size_t FetchSizeMax = 16 * 1024;
+const size_t FetchBytes = 4 * 1024 * 1024; // per round trip
+const double FetchGain = 1.1; // rows/sec ratio which justifies bigger round trips
+const size_t PageRows = 1024; // page is full at PageRows or PageBytes, whichever comes first
+const size_t PageBytes = 1024 * 1024;
+const size_t PageArenaBlock = 64 * 1024; // bytes
+const size_t PageRingSize = 4; // pages fetched ahead by threaded_rowset / threaded_command
+const size_t ProviderBudget = 64 * 1024 * 1024; // bytes of pages fetched ahead by all commands of the provider
+const size_t MediatorSpinCount = 100; // yields before a thread parks
+const size_t ExecutorSize = 8; // minimum of shared threads, database calls block them
+const size_t StatementCacheSize = 16; // prepared statements per connection
+const double IndexJoinCost = 4; // scanned rows per row through a spatial index join, see database::detail::choose_spatial_access()
+const size_t IndexRowsMin = 1000; // smaller tables are scanned
+const double CoverGainMin = 0.1; // share of the box area which justifies its split, see boost::cover()
+const size_t DeferredBatchSize = 64; // rows whose heavy columns are selected at once, see database::provider::select_deferred()
+const size_t PoolMinSize = 0; // see database::pool_options
+const size_t PoolSize = 4; // idle commands
+const size_t PoolIdleSec = 300;
+const size_t CacheTtlSec = 60; // metadata cached by database::provider
 const size_t TimeoutSec = 120;
 
 const char TableName[] = "tbl";
@@ -0,0 +1,74 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_LAZY_ROW_HPP
+#define BRIG_LAZY_ROW_HPP
+
+#include <boost/utility.hpp>
+#include <brig/column_type.hpp>
+#include <brig/detail/type_visitor.hpp>
+#include <brig/variant.hpp>
+#include <vector>
+
+namespace brig {
+
+/*!
+decoder of the current row of a rowset, see rowset::fetch_lazy()
+*/
+struct column_reader {
+  virtual ~column_reader()  {}
+  virtual size_t size() = 0;
+  virtual column_type type(size_t col) = 0; // Void - null, without decoding
+  virtual void read(size_t col, variant& var) = 0;
+}; // column_reader
+
+/*!
+row of rowset::fetch_lazy(): types and nulls are cheap, a column is decoded by its first get(),
+the row is valid until the next call of the rowset
+*/
+class lazy_row : ::boost::noncopyable {
+  column_reader* m_reader; // 0 - decoded row
+  std::vector<variant> m_row;
+  std::vector<bool> m_read;
+
+public:
+  lazy_row() : m_reader(0)  {}
+
+  // rowset
+  void reset(column_reader& reader);
+  std::vector<variant>& reset(); // for eager decoding
+
+  // consumer
+  size_t size()  { return m_reader? m_reader->size(): m_row.size(); }
+  column_type type(size_t col)  { return m_reader? m_reader->type(col): ::boost::apply_visitor(detail::type_visitor(), m_row[col]); }
+  bool is_null(size_t col)  { return column_type::Void == type(col); }
+  const variant& get(size_t col);
+}; // lazy_row
+
+inline void lazy_row::reset(column_reader& reader)
+{
+  m_reader = &reader;
+  const size_t count(reader.size());
+  m_row.resize(count); // values are kept for recycling
+  m_read.assign(count, false);
+}
+
+inline std::vector<variant>& lazy_row::reset()
+{
+  m_reader = 0;
+  m_read.clear();
+  return m_row;
+}
+
+inline const variant& lazy_row::get(size_t col)
+{
+  if (m_reader && !m_read[col])
+  {
+    m_reader->read(col, m_row[col]);
+    m_read[col] = true;
+  }
+  return m_row[col];
+} // lazy_row::
+
+} // brig
+
+#endif // BRIG_LAZY_ROW_HPP
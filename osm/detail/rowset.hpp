@@ -5,12 +5,14 @@
 
 #include <brig/boost/geometry.hpp>
 #include <brig/boost/as_binary.hpp>
+#include <brig/detail/recycle.hpp>
 #include <brig/global.hpp>
 #include <brig/osm/detail/lib.hpp>
 #include <brig/osm/detail/tile.hpp>
 #include <brig/osm/detail/tiles.hpp>
 #include <brig/osm/layer.hpp>
 #include <brig/rowset.hpp>
+#include <atomic>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
@@ -34,18 +36,22 @@ class rowset : public brig::rowset
   tiles m_tls;
   CURLM* m_hnd;
   std::unordered_map<CURL*, data_t> m_pg;
+  std::atomic<bool> m_cancelled;
 
   static size_t write(void* ptr, size_t size, size_t nmemb, blob_t* blob);
   static void check(CURLcode r);
   static void check(CURLMcode r);
 
   void add_files();
+  void remove_files();
+  void check_cancelled();
 
 public:
   rowset(std::shared_ptr<layer> lr, const std::vector<bool>& cols, int zoom, const boost::box& env, int rows);
   ~rowset() override;
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
+  void cancel() override  { m_cancelled = true; } // transfers are removed by the fetching thread, cURL handles are not thread-safe
 }; // rowset
 
 inline size_t rowset::write(void* ptr, size_t size, size_t nmemb, blob_t* blob)
@@ -73,7 +79,7 @@ inline void rowset::check(CURLMcode r)
 }
 
 inline rowset::rowset(std::shared_ptr<layer> lr, const std::vector<bool>& cols, int zoom, const boost::box& env, int rows)
-  : m_lr(lr), m_cols(cols), m_rows(rows), m_tls(zoom, env), m_hnd(0)
+  : m_lr(lr), m_cols(cols), m_rows(rows), m_tls(zoom, env), m_hnd(0), m_cancelled(false)
 {
   if (lib::singleton().empty()) throw std::runtime_error("cURL error");
   m_hnd = lib::singleton().p_curl_multi_init();
@@ -81,6 +87,12 @@ inline rowset::rowset(std::shared_ptr<layer> lr, const std::vector<bool>& cols,
 }
 
 inline rowset::~rowset()
+{
+  remove_files();
+  lib::singleton().p_curl_multi_cleanup(m_hnd);
+}
+
+inline void rowset::remove_files()
 {
   for (auto row: m_pg)
   {
@@ -88,7 +100,15 @@ inline rowset::~rowset()
     lib::singleton().p_curl_easy_cleanup(row.first);
     delete row.second.rast;
   }
-  lib::singleton().p_curl_multi_cleanup(m_hnd);
+  m_pg.clear();
+}
+
+inline void rowset::check_cancelled()
+{
+  if (!m_cancelled) return;
+  remove_files();
+  m_rows = 0;
+  throw std::runtime_error("cancel error");
 }
 
 inline std::vector<std::string> rowset::columns()
@@ -133,6 +153,7 @@ inline void rowset::add_files()
 
 inline bool rowset::fetch(std::vector<variant>& row)
 {
+  check_cancelled();
   if (m_pg.size() < (PageSize / 4))
     add_files();
 
@@ -144,6 +165,7 @@ inline bool rowset::fetch(std::vector<variant>& row)
     int still_running(0);
     while (lib::singleton().p_curl_multi_perform(m_hnd, &still_running) == CURLM_CALL_MULTI_PERFORM);
     if (still_running != int(m_pg.size())) break;
+    check_cancelled();
     add_files();
   }
 
@@ -160,8 +182,7 @@ inline bool rowset::fetch(std::vector<variant>& row)
   {
     if (m_cols[i])
     {
-      row[i] = blob_t();
-      blob_t& blob = ::boost::get<blob_t>(row[i]);
+      blob_t& blob = brig::detail::recycle<blob_t>(row[i]);
       blob.assign(begin(*data.rast), end(*data.rast));
     }
     else
@@ -40,6 +40,7 @@ public:
   table_def get_table_def(const identifier& tbl) override;
   boost::box get_extent(const table_def& tbl) override;
   std::shared_ptr<rowset> select(const table_def& tbl) override;
+  using brig::provider::select;
 
   bool is_readonly() override  { return true; }
   table_def fit_to_create(const table_def&) override  { throw std::runtime_error("OSM error"); }
@@ -4,6 +4,7 @@
 #define BRIG_PROJ_TRANSFORM_WKB_HPP
 
 #include <brig/blob_t.hpp>
+#include <brig/blob_view.hpp>
 #include <brig/proj/detail/lib.hpp>
 #include <brig/proj/detail/transform_geometry.hpp>
 
@@ -16,6 +17,17 @@ inline void transform_wkb(blob_t& wkb, projPJ in_pj, projPJ out_pj)
   detail::transform_geometry(in_ptr, out_ptr, in_pj, out_pj);
 }
 
+/*!
+transforms borrowed WKB (see rowset::fetch_view()) into the reused buffer
+*/
+inline void transform_wkb(const blob_view& in_wkb, blob_t& out_wkb, projPJ in_pj, projPJ out_pj)
+{
+  out_wkb.resize(in_wkb.size());
+  const blob_t::value_type* in_ptr(in_wkb.data());
+  blob_t::value_type* out_ptr(out_wkb.data());
+  detail::transform_geometry(in_ptr, out_ptr, in_pj, out_pj);
+}
+
 } } // brig::proj
 
 #endif // BRIG_PROJ_TRANSFORM_WKB_HPP
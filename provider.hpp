@@ -5,6 +5,9 @@
 
 #include <boost/utility.hpp>
 #include <brig/boost/geometry.hpp>
+#include <brig/cancellation_token.hpp>
+#include <brig/detail/cancellable_rowset.hpp>
+#include <brig/detail/submit_async.hpp>
 #include <brig/identifier.hpp>
 #include <brig/insert_iterator.hpp>
 #include <brig/inserter.hpp>
@@ -12,6 +15,7 @@
 #include <brig/rowset.hpp>
 #include <brig/rowset_iterator.hpp>
 #include <brig/table_def.hpp>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,8 +30,13 @@ struct provider : ::boost::noncopyable
   virtual std::vector<identifier> get_geometry_layers() = 0;
   virtual std::vector<pyramid_def> get_raster_layers() = 0;
   virtual table_def get_table_def(const identifier& tbl) = 0;
+  virtual std::vector<table_def> get_table_defs(const std::vector<identifier>& tbls);
   virtual boost::box get_extent(const table_def& tbl) = 0;
   virtual std::shared_ptr<rowset> select(const table_def& tbl) = 0;
+  /*!
+  the token (its deadline too) cancels the rowset, the call throws "cancel error" if the token is already cancelled
+  */
+  virtual std::shared_ptr<rowset> select(const table_def& tbl, const cancellation_token& token);
 
   virtual bool is_readonly() = 0;
   /*!
@@ -42,8 +51,30 @@ struct provider : ::boost::noncopyable
   virtual void reg(const pyramid_def& raster) = 0;
   virtual void unreg(const pyramid_def& raster) = 0;
   virtual std::shared_ptr<inserter> get_inserter(const table_def& tbl) = 0;
+
+  /*!
+  calls are run by detail::async_executor(), the provider must outlive the futures;
+  independent calls overlap on pooled commands, select results keep prefetching with threading
+  */
+  std::future<std::shared_ptr<rowset>> select_async(const table_def& tbl)  { return detail::submit_async([this, tbl]()  { return select(tbl); }); }
+  std::future<std::shared_ptr<rowset>> select_async(const table_def& tbl, const cancellation_token& token)  { return detail::submit_async([this, tbl, token]()  { return select(tbl, token); }); }
+  std::future<table_def> get_table_def_async(const identifier& tbl)  { return detail::submit_async([this, tbl]()  { return get_table_def(tbl); }); }
+  std::future<boost::box> get_extent_async(const table_def& tbl)  { return detail::submit_async([this, tbl]()  { return get_extent(tbl); }); }
 }; // provider
 
+inline std::shared_ptr<rowset> provider::select(const table_def& tbl, const cancellation_token& token)
+{
+  token.check();
+  return std::make_shared<detail::cancellable_rowset>(select(tbl), token);
+}
+
+inline std::vector<table_def> provider::get_table_defs(const std::vector<identifier>& tbls)
+{
+  std::vector<table_def> res;
+  for (const auto& tbl: tbls) res.push_back(get_table_def(tbl));
+  return res;
+} // provider::
+
 } // brig
 
 #endif // BRIG_PROVIDER_HPP
@@ -4,6 +4,8 @@
 #define BRIG_ROWSET_HPP
 
 #include <boost/utility.hpp>
+#include <brig/column_batch.hpp>
+#include <brig/lazy_row.hpp>
 #include <brig/variant.hpp>
 #include <string>
 #include <vector>
@@ -14,8 +16,32 @@ struct rowset : ::boost::noncopyable {
   virtual ~rowset()  {}
   virtual std::vector<std::string> columns() = 0;
   virtual bool fetch(std::vector<variant>& row) = 0;
+  /*!
+  strings and blobs may be returned as string_view / blob_view, borrowed from the driver and valid until the next call of the rowset
+  */
+  virtual bool fetch_view(std::vector<variant>& row)  { return fetch(row); }
+  /**
+  @return count of fetched rows, zero at the end
+  */
+  virtual size_t fetch_batch(column_batch& batch, size_t max_rows);
+  /*!
+  columns are decoded on demand by lazy_row::get(), for example after a cheap test of the others; by default the row is decoded at once
+  */
+  virtual bool fetch_lazy(lazy_row& row)  { return fetch(row.reset()); }
+  /*!
+  may be called from another thread, interrupts a blocking call of the rowset (the call throws), see cancellation_token
+  */
+  virtual void cancel()  {}
 }; // rowset
 
+inline size_t rowset::fetch_batch(column_batch& batch, size_t max_rows)
+{
+  std::vector<variant> row;
+  batch.clear();
+  while (batch.rows < max_rows && fetch(row)) batch.push_back(row);
+  return batch.rows;
+} // rowset::
+
 } // brig
 
 #endif // BRIG_ROWSET_HPP
@@ -0,0 +1,178 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_SHARDED_PROVIDER_HPP
+#define BRIG_SHARDED_PROVIDER_HPP
+
+#include <algorithm>
+#include <boost/geometry/geometry.hpp>
+#include <brig/boost/envelope.hpp>
+#include <brig/boost/geom_from_wkb.hpp>
+#include <brig/boost/geometry.hpp>
+#include <brig/detail/gather_rowset.hpp>
+#include <brig/provider.hpp>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace brig {
+
+/*!
+scatter-gather over providers with the same tables:\n
+* select() queries the shards whose footprint intersects the query box, shards without footprint are always queried\n
+* shard queries run concurrently, rows are gathered in order of arrival (see detail::gather_rowset)\n
+* get_extent() is the union of the extents, get_table_def() keeps the columns and indexes common to all shards\n
+* get_raster_layers() keeps the pyramids and their levels common to all shards\n
+* catalog calls run on their own threads, so they may be called from detail::async_executor() (the *_async calls)\n
+* shards are read-only through this provider, write to them directly\n
+*/
+class sharded_provider : public provider {
+public:
+  struct shard {
+    std::shared_ptr<provider> prv;
+    bool bounded;
+    boost::box footprint;
+
+    explicit shard(std::shared_ptr<provider> prv_) : prv(prv_), bounded(false)  {}
+    shard(std::shared_ptr<provider> prv_, const boost::box& footprint_) : prv(prv_), bounded(true), footprint(footprint_)  {}
+  }; // shard
+
+private:
+  std::vector<shard> m_shards;
+
+  template <typename Fn>
+  auto scatter(Fn fn) -> std::vector<decltype(fn(std::shared_ptr<provider>()))>;
+  static bool same(const identifier& a, const identifier& b)  { return a.schema == b.schema && a.name == b.name && a.qualifier == b.qualifier; }
+  static std::vector<identifier> intersect(const std::vector<std::vector<identifier>>& lists);
+
+public:
+  explicit sharded_provider(const std::vector<shard>& shards);
+  size_t size() const  { return m_shards.size(); }
+
+  std::vector<identifier> get_tables() override  { return intersect(scatter([](std::shared_ptr<provider> prv)  { return prv->get_tables(); })); }
+  std::vector<identifier> get_geometry_layers() override  { return intersect(scatter([](std::shared_ptr<provider> prv)  { return prv->get_geometry_layers(); })); }
+  std::vector<pyramid_def> get_raster_layers() override;
+  table_def get_table_def(const identifier& tbl) override;
+  boost::box get_extent(const table_def& tbl) override;
+  std::shared_ptr<rowset> select(const table_def& tbl) override;
+  using provider::select;
+
+  bool is_readonly() override  { return true; }
+  table_def fit_to_create(const table_def&) override  { throw std::runtime_error("shard error"); }
+  void create(const table_def&) override  { throw std::runtime_error("shard error"); }
+  void drop(const table_def&) override  { throw std::runtime_error("shard error"); }
+  pyramid_def fit_to_reg(const pyramid_def&) override  { throw std::runtime_error("shard error"); }
+  void reg(const pyramid_def&) override  { throw std::runtime_error("shard error"); }
+  void unreg(const pyramid_def&) override  { throw std::runtime_error("shard error"); }
+  std::shared_ptr<inserter> get_inserter(const table_def&) override  { throw std::runtime_error("shard error"); }
+}; // sharded_provider
+
+inline sharded_provider::sharded_provider(const std::vector<shard>& shards) : m_shards(shards)
+{
+  if (m_shards.empty()) throw std::runtime_error("shard error");
+}
+
+template <typename Fn>
+auto sharded_provider::scatter(Fn fn) -> std::vector<decltype(fn(std::shared_ptr<provider>()))>
+{
+  using namespace std;
+  typedef decltype(fn(shared_ptr<provider>())) result_type;
+  vector<future<result_type>> futures;
+  for (size_t i(1); i < m_shards.size(); ++i)
+  {
+    auto prv(m_shards[i].prv);
+    futures.push_back(async(launch::async, [fn, prv]()  { return fn(prv); })); // not async_executor(), see above
+  }
+  vector<result_type> res;
+  res.push_back(fn(m_shards.front().prv)); // on the calling thread
+  for (auto& f: futures) res.push_back(f.get());
+  return res;
+}
+
+inline std::vector<identifier> sharded_provider::intersect(const std::vector<std::vector<identifier>>& lists)
+{
+  using namespace std;
+  vector<identifier> res;
+  for (const auto& id: lists.front())
+    if (all_of(begin(lists) + 1, end(lists), [&](const vector<identifier>& list)
+      { return any_of(begin(list), end(list), [&](const identifier& other)  { return same(id, other); }); }))
+      res.push_back(id);
+  return res;
+}
+
+inline std::vector<pyramid_def> sharded_provider::get_raster_layers()
+{
+  using namespace std;
+  const vector<vector<pyramid_def>> lists(scatter([](shared_ptr<provider> prv)  { return prv->get_raster_layers(); }));
+  vector<pyramid_def> res;
+  for (auto raster: lists.front())
+  {
+    vector<const pyramid_def*> others;
+    for (auto list(begin(lists) + 1); list != end(lists); ++list)
+    {
+      auto other(find_if(begin(*list), end(*list), [&](const pyramid_def& r)  { return same(raster.id, r.id); }));
+      if (other == end(*list)) break;
+      others.push_back(&*other);
+    }
+    if (others.size() + 1 < lists.size()) continue;
+    raster.levels.erase(remove_if(begin(raster.levels), end(raster.levels), [&](const tilemap_def& lvl)
+    {
+      return !all_of(begin(others), end(others), [&](const pyramid_def* other)
+        { return any_of(begin(other->levels), end(other->levels), [&](const tilemap_def& l)  { return same(lvl.geometry, l.geometry) && lvl.raster.name == l.raster.name; }); });
+    }), end(raster.levels));
+    if (!raster.levels.empty()) res.push_back(raster);
+  }
+  return res;
+}
+
+inline table_def sharded_provider::get_table_def(const identifier& tbl)
+{
+  using namespace std;
+  const vector<table_def> defs(scatter([tbl](shared_ptr<provider> prv)  { return prv->get_table_def(tbl); }));
+  table_def res(defs.front());
+  auto is_common([&](const string& col)  { return all_of(begin(defs) + 1, end(defs), [&](const table_def& def)  { return def[col] != 0; }); });
+  res.columns.erase(remove_if(begin(res.columns), end(res.columns), [&](const column_def& col)  { return !is_common(col.name); }), end(res.columns));
+  res.indexes.erase(remove_if(begin(res.indexes), end(res.indexes), [&](const index_def& idx)  { return !all_of(begin(idx.columns), end(idx.columns), is_common); }), end(res.indexes));
+  return res;
+}
+
+inline boost::box sharded_provider::get_extent(const table_def& tbl)
+{
+  using namespace std;
+  const vector<boost::box> boxes(scatter([tbl](shared_ptr<provider> prv)  { return prv->get_extent(tbl); }));
+  boost::box res(boxes.front());
+  for (auto box(begin(boxes) + 1); box != end(boxes); ++box) ::boost::geometry::expand(res, *box);
+  return res;
+}
+
+inline std::shared_ptr<rowset> sharded_provider::select(const table_def& tbl)
+{
+  using namespace std;
+  using namespace brig::boost;
+
+  auto geom_col(find_if(begin(tbl.columns), end(tbl.columns), [](const column_def& col){ return column_type::Geometry == col.type && typeid(blob_t) == col.query_value.type(); }));
+  const bool spatial(geom_col != end(tbl.columns) && !::boost::get<blob_t>(geom_col->query_value).empty());
+  box query;
+  if (spatial) query = envelope(geom_from_wkb(::boost::get<blob_t>(geom_col->query_value)));
+
+  vector<brig::detail::gather_rowset::source> sources;
+  for (const auto& sh: m_shards)
+    if (!spatial || !sh.bounded || ::boost::geometry::intersects(sh.footprint, query))
+    {
+      auto prv(sh.prv);
+      sources.push_back([prv, tbl]()  { return prv->select(tbl); });
+    }
+  if (sources.empty())
+  {
+    table_def empty(tbl); // for columns
+    empty.query_rows = 0;
+    return m_shards.front().prv->select(empty);
+  }
+  return make_shared<brig::detail::gather_rowset>(sources, tbl.query_rows);
+} // sharded_provider::
+
+} // brig
+
+#endif // BRIG_SHARDED_PROVIDER_HPP
@@ -0,0 +1,45 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_STRING_VIEW_HPP
+#define BRIG_STRING_VIEW_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace brig {
+
+/*!
+borrowed UTF-8 characters (driver memory), valid until the next fetch
+*/
+class string_view {
+  const char* m_data;
+  size_t m_size;
+
+public:
+  string_view() : m_data(""), m_size(0)  {}
+  string_view(const char* data, size_t size) : m_data(data? data: ""), m_size(data? size: 0)  {}
+  explicit string_view(const char* str) : m_data(str? str: ""), m_size(str? strlen(str): 0)  {}
+  explicit string_view(const std::string& str) : m_data(str.c_str()), m_size(str.size())  {}
+  const char* data() const  { return m_data; }
+  size_t size() const  { return m_size; }
+  bool empty() const  { return m_size == 0; }
+  const char* begin() const  { return m_data; }
+  const char* end() const  { return m_data + m_size; }
+  std::string to_string() const  { return std::string(m_data, m_size); }
+}; // string_view
+
+} // brig
+
+namespace std {
+
+template <typename CharT, typename TraitsT>
+basic_ostream<CharT, TraitsT>& operator<<(basic_ostream<CharT, TraitsT>& stream, const brig::string_view& str)
+{
+  return stream << str.to_string().c_str();
+}
+
+} // std
+
+#endif // BRIG_STRING_VIEW_HPP
@@ -0,0 +1,168 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_TEE_ROWSET_HPP
+#define BRIG_TEE_ROWSET_HPP
+
+#include <algorithm>
+#include <boost/utility.hpp>
+#include <brig/detail/page_cursor.hpp>
+#include <brig/global.hpp>
+#include <brig/rowset.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brig {
+
+/*!
+fan-out of one rowset to several consumers:\n
+* the source is read once by pages of PageRows rows, the consumer which needs a new page reads it\n
+* pages are shared by reference counting and retained until the slowest consumer has taken them\n
+* a consumer waits while max_lag pages are retained, so every consumer must be read or released\n
+* consumers may run in different threads, wrap the source in threaded_rowset to read it on a worker\n
+* values keep the types of the source rowset\n
+*/
+class tee_rowset : ::boost::noncopyable {
+  typedef std::shared_ptr<const detail::row_page> page_ptr;
+
+  struct state : ::boost::noncopyable {
+    std::shared_ptr<rowset> src;
+    std::vector<std::string> cols;
+    std::deque<page_ptr> pages;
+    size_t first; // number of pages[0]
+    std::vector<size_t> positions; // of consumers, number of the next page
+    size_t max_lag;
+    bool reading, done;
+    std::exception_ptr exc;
+    std::mutex mut;
+    std::condition_variable cond;
+
+    state(std::shared_ptr<rowset> src_, size_t consumers, size_t max_lag_);
+    void trim();
+    page_ptr next(size_t consumer); // null at the end
+    void release(size_t consumer);
+  }; // state
+
+  class consumer : public rowset {
+    std::shared_ptr<state> m_st;
+    size_t m_id;
+    detail::page_cursor m_cur;
+
+    bool ready();
+    bool fetch(std::vector<variant>& row, bool view);
+
+  public:
+    consumer(std::shared_ptr<state> st, size_t id) : m_st(st), m_id(id)  {}
+    ~consumer() override  { m_st->release(m_id); }
+    std::vector<std::string> columns() override  { return m_st->cols; }
+    bool fetch(std::vector<variant>& row) override  { return fetch(row, false); }
+    bool fetch_view(std::vector<variant>& row) override  { return fetch(row, true); }
+    void cancel() override  { m_st->src->cancel(); }
+  }; // consumer
+
+  std::vector<std::shared_ptr<rowset>> m_consumers;
+
+public:
+  tee_rowset(std::shared_ptr<rowset> rs, size_t consumers, size_t max_lag = PageRingSize);
+  size_t size() const  { return m_consumers.size(); }
+  std::shared_ptr<rowset> operator[](size_t i) const  { return m_consumers[i]; }
+}; // tee_rowset
+
+inline tee_rowset::state::state(std::shared_ptr<rowset> src_, size_t consumers, size_t max_lag_)
+  : src(src_), cols(src_->columns()), first(0), positions(consumers, 0), max_lag(std::max<>(max_lag_, size_t(1))), reading(false), done(false)
+{
+}
+
+inline void tee_rowset::state::trim()
+{
+  const size_t slowest(*std::min_element(positions.begin(), positions.end()));
+  while (!pages.empty() && first < slowest)
+  {
+    pages.pop_front();
+    ++first;
+  }
+}
+
+inline tee_rowset::page_ptr tee_rowset::state::next(size_t consumer)
+{
+  using namespace std;
+  unique_lock<mutex> lock(mut);
+  while (true)
+  {
+    const size_t pos(positions[consumer]);
+    if (pos < first + pages.size())
+    {
+      page_ptr pg(pages[pos - first]);
+      ++positions[consumer];
+      trim();
+      cond.notify_all();
+      return pg;
+    }
+    if (done)
+    {
+      if (!(exc == 0)) rethrow_exception(exc);
+      return page_ptr();
+    }
+    if (!reading && pages.size() < max_lag)
+    {
+      reading = true;
+      lock.unlock();
+      shared_ptr<detail::row_page> pg(make_shared<detail::row_page>());
+      exception_ptr e;
+      try  { if (detail::read_page(*src, *pg, PageRows) == 0) pg.reset(); }
+      catch (const exception&)  { pg.reset(); e = current_exception(); }
+      lock.lock();
+      reading = false;
+      if (pg) pages.push_back(pg);
+      else
+      {
+        done = true;
+        exc = e;
+      }
+      cond.notify_all();
+      continue;
+    }
+    cond.wait(lock);
+  }
+}
+
+inline void tee_rowset::state::release(size_t consumer)
+{
+  std::lock_guard<std::mutex> lock(mut);
+  positions[consumer] = std::numeric_limits<size_t>::max(); // never holds the others back
+  trim();
+  cond.notify_all();
+} // tee_rowset::state::
+
+inline bool tee_rowset::consumer::ready()
+{
+  while (m_cur.empty())
+  {
+    page_ptr pg(m_st->next(m_id));
+    if (!pg) return false;
+    m_cur.reset(pg);
+  }
+  return true;
+}
+
+inline bool tee_rowset::consumer::fetch(std::vector<variant>& row, bool view)
+{
+  if (!ready()) return false;
+  m_cur.fetch(row, view);
+  return true;
+} // tee_rowset::consumer::
+
+inline tee_rowset::tee_rowset(std::shared_ptr<rowset> rs, size_t consumers, size_t max_lag)
+{
+  auto st(std::make_shared<state>(rs, consumers, max_lag));
+  for (size_t i(0); i < consumers; ++i) m_consumers.push_back(std::make_shared<consumer>(st, i));
+} // tee_rowset::
+
+} // brig
+
+#endif // BRIG_TEE_ROWSET_HPP
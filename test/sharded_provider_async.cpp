@@ -0,0 +1,76 @@
+// Andrew Naplavkov
+
+// more concurrent *_async calls of sharded_provider than threads of detail::async_executor(), exit code 1 on a hang
+// g++ -std=c++11 -O2 -I<dir containing brig> -I<boost> sharded_provider_async.cpp -pthread
+
+#include <brig/sharded_provider.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct slow_shard : brig::provider {
+  std::vector<brig::identifier> get_tables() override  { return std::vector<brig::identifier>(); }
+  std::vector<brig::identifier> get_geometry_layers() override  { return std::vector<brig::identifier>(); }
+  std::vector<brig::pyramid_def> get_raster_layers() override  { return std::vector<brig::pyramid_def>(); }
+  brig::table_def get_table_def(const brig::identifier& id) override;
+  brig::boost::box get_extent(const brig::table_def&) override  { return brig::boost::box(brig::boost::point(0, 0), brig::boost::point(1, 1)); }
+  std::shared_ptr<brig::rowset> select(const brig::table_def&) override  { throw std::runtime_error("test error"); }
+
+  bool is_readonly() override  { return true; }
+  brig::table_def fit_to_create(const brig::table_def&) override  { throw std::runtime_error("test error"); }
+  void create(const brig::table_def&) override  { throw std::runtime_error("test error"); }
+  void drop(const brig::table_def&) override  { throw std::runtime_error("test error"); }
+  brig::pyramid_def fit_to_reg(const brig::pyramid_def&) override  { throw std::runtime_error("test error"); }
+  void reg(const brig::pyramid_def&) override  { throw std::runtime_error("test error"); }
+  void unreg(const brig::pyramid_def&) override  { throw std::runtime_error("test error"); }
+  std::shared_ptr<brig::inserter> get_inserter(const brig::table_def&) override  { throw std::runtime_error("test error"); }
+}; // slow_shard
+
+inline brig::table_def slow_shard::get_table_def(const brig::identifier& id)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(10)); // keeps the pool busy
+  brig::table_def res;
+  res.id = id;
+  return res;
+} // slow_shard::
+
+int main()
+{
+  using namespace std;
+  vector<brig::sharded_provider::shard> shards;
+  shards.push_back(brig::sharded_provider::shard(make_shared<slow_shard>()));
+  shards.push_back(brig::sharded_provider::shard(make_shared<slow_shard>()));
+  brig::sharded_provider prv(shards);
+  brig::identifier id;
+  id.name = "t";
+
+  const size_t calls(4 * brig::detail::async_executor().size());
+  vector<future<brig::table_def>> table_defs;
+  vector<future<brig::boost::box>> extents;
+  for (size_t i(0); i < calls; ++i)
+  {
+    table_defs.push_back(prv.get_table_def_async(id));
+    extents.push_back(prv.get_extent_async(brig::table_def()));
+  }
+
+  const auto deadline(chrono::steady_clock::now() + chrono::seconds(30));
+  for (size_t i(0); i < calls; ++i)
+    if (table_defs[i].wait_until(deadline) != future_status::ready || extents[i].wait_until(deadline) != future_status::ready)
+    {
+      cout << "hang after " << i << " of " << calls << " calls" << endl;
+      _Exit(EXIT_FAILURE); // blocked tasks would never let the executor stop
+    }
+  for (size_t i(0); i < calls; ++i)
+    if (table_defs[i].get().id.name != id.name)
+    {
+      cout << "wrong table" << endl;
+      return EXIT_FAILURE;
+    }
+  cout << calls << " calls ok" << endl;
+  return EXIT_SUCCESS;
+}
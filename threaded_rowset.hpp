@@ -3,34 +3,59 @@
 #ifndef BRIG_THREADED_ROWSET_HPP
 #define BRIG_THREADED_ROWSET_HPP
 
-#include <brig/detail/double_page.hpp>
+#include <brig/detail/byte_budget.hpp>
 #include <brig/detail/mediator.hpp>
+#include <brig/detail/page_ring.hpp>
+#include <brig/executor.hpp>
+#include <brig/global.hpp>
 #include <brig/rowset.hpp>
+#include <functional>
 #include <memory>
-#include <thread>
 
 namespace brig {
 
 class threaded_rowset : public rowset {
-  struct mediator : detail::mediator<rowset>  { detail::double_page dpg; };
+  struct mediator : detail::mediator<rowset> {
+    std::shared_ptr<rowset> rs;
+    detail::page_ring ring;
+    mediator(std::shared_ptr<rowset> rs_, size_t pages, std::shared_ptr<detail::byte_budget> budget) : rs(rs_), ring(pages, budget, [this](){ this->wake(); })  {}
+  }; // mediator
   std::shared_ptr<mediator> m_med;
+  static void run(std::shared_ptr<mediator> med); // until idle
 public:
-  explicit threaded_rowset(std::shared_ptr<rowset> rs);
+  explicit threaded_rowset
+    ( std::shared_ptr<rowset> rs
+    , size_t pages = PageRingSize
+    , executor& exec = executor::singleton()
+    , std::shared_ptr<detail::byte_budget> budget = std::shared_ptr<detail::byte_budget>()
+    );
   ~threaded_rowset() override  { m_med->stop(); }
   std::vector<std::string> columns() override;
   bool fetch(std::vector<variant>& row) override;
+  bool fetch_view(std::vector<variant>& row) override;
+  void cancel() override  { m_med->rs->cancel(); } // bypasses the mediator, the producer is blocked in the call
 }; // threaded_rowset
 
-inline threaded_rowset::threaded_rowset(std::shared_ptr<rowset> rs) : m_med(new mediator())
+inline threaded_rowset::threaded_rowset(std::shared_ptr<rowset> rs, size_t pages, executor& exec, std::shared_ptr<detail::byte_budget> budget)
+  : m_med(new mediator(rs, pages, budget))
 {
   using namespace std;
-  auto worker = [](shared_ptr<rowset> rs, shared_ptr<mediator> med)
+  weak_ptr<mediator> weak(m_med);
+  m_med->set_scheduler([weak, &exec]()
   {
-    med->start();
-    while (med->handle(rs.get())) med->dpg.prefill(rs.get());
-  };
-  thread t(worker, rs, m_med);
-  t.detach();
+    shared_ptr<mediator> med(weak.lock());
+    if (med) exec.submit(bind(&threaded_rowset::run, med));
+  });
+  m_med->start();
+  exec.submit(bind(&threaded_rowset::run, m_med));
+}
+
+inline void threaded_rowset::run(std::shared_ptr<mediator> med)
+{
+  while (med->handle(med->rs.get(), false))
+    if (med->ring.ready()) med->ring.fill(med->rs.get());
+    else if (med->suspend()) return;
+  med->rs.reset();
 }
 
 inline std::vector<std::string> threaded_rowset::columns()
@@ -40,8 +65,12 @@ inline std::vector<std::string> threaded_rowset::columns()
 
 inline bool threaded_rowset::fetch(std::vector<variant>& row)
 {
-  if (m_med->dpg.empty()) m_med->call<void>(&detail::double_page::fill, &m_med->dpg, std::placeholders::_1);
-  return m_med->dpg.fetch(row);
+  return m_med->ring.fetch(row);
+}
+
+inline bool threaded_rowset::fetch_view(std::vector<variant>& row)
+{
+  return m_med->ring.fetch_view(row);
 } // threaded_rowset::
 
 } // brig
@@ -0,0 +1,40 @@
+// Andrew Naplavkov
+
+// round trip of detail::mediator<>::call() against a trivial interface
+// g++ -std=c++11 -O2 -I<dir containing brig> -I<boost> mediator_latency.cpp -pthread
+
+#include <algorithm>
+#include <brig/detail/mediator.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+struct trivial {
+  int add(int a, int b)  { return a + b; }
+}; // trivial
+
+int main(int argc, char* argv[])
+{
+  using namespace std;
+  using namespace std::chrono;
+  const int calls(argc > 1? atoi(argv[1]): 20000);
+  brig::detail::mediator<trivial> med;
+  thread handler([&]()
+  {
+    trivial iface;
+    med.start();
+    while (med.handle(&iface));
+  });
+
+  long long sum(0);
+  const auto start(steady_clock::now());
+  for (int i(0); i < calls; ++i) sum += med.call<int>(&trivial::add, placeholders::_1, i, 1);
+  const auto finish(steady_clock::now());
+  med.stop();
+  handler.join();
+
+  cout << calls << " calls, round trip " << duration_cast<nanoseconds>(finish - start).count() / max<>(calls, 1) << " ns (checksum " << sum << ")" << endl;
+  return 0;
+}
@@ -0,0 +1,81 @@
+// Andrew Naplavkov
+
+#ifndef BRIG_TYPED_ROWSET_HPP
+#define BRIG_TYPED_ROWSET_HPP
+
+#include <array>
+#include <boost/utility.hpp>
+#include <brig/detail/typed_value.hpp>
+#include <brig/rowset.hpp>
+#include <brig/variant.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace brig {
+
+/*!
+rows decoded into std::tuple<Types...>, e.g. typed_rowset<int64_t, std::string, blob_t>:\n
+* a column keeps the decoder (function pointer) of the last type of its values, so it is resolved again only if the type changes (e.g. null)\n
+* values are taken by fetch_view(), so strings and blobs of the tuple reuse their capacity\n
+* nulls are decoded as T(), see is_null()\n
+*/
+template <typename... Types>
+class typed_rowset : ::boost::noncopyable {
+  typedef detail::typed_decoder (*resolver)(int);
+  static const size_t Size = sizeof...(Types);
+
+  std::shared_ptr<rowset> m_rs;
+  std::vector<variant> m_row;
+  std::array<int, Size> m_which;
+  std::array<detail::typed_decoder, Size> m_decoders;
+  std::array<bool, Size> m_nulls;
+
+  template <size_t I>
+  static typename std::enable_if<I < Size>::type get_pointers(std::tuple<Types...>& row, void** ptrs)  { ptrs[I] = &std::get<I>(row); get_pointers<I + 1>(row, ptrs); }
+  template <size_t I>
+  static typename std::enable_if<I == Size>::type get_pointers(std::tuple<Types...>&, void**)  {}
+
+public:
+  explicit typed_rowset(std::shared_ptr<rowset> rs);
+  std::vector<std::string> columns()  { return m_rs->columns(); }
+  bool fetch(std::tuple<Types...>& row);
+  bool is_null(size_t col) const  { return m_nulls[col]; } // of the last fetched row
+}; // typed_rowset
+
+template <typename... Types>
+typed_rowset<Types...>::typed_rowset(std::shared_ptr<rowset> rs) : m_rs(rs)
+{
+  m_which.fill(-1);
+  m_decoders.fill(0);
+  m_nulls.fill(true);
+}
+
+template <typename... Types>
+bool typed_rowset<Types...>::fetch(std::tuple<Types...>& row)
+{
+  static const resolver resolvers[] = { &detail::get_typed_decoder<Types>... };
+  if (!m_rs->fetch_view(m_row)) return false;
+  if (m_row.size() != Size) throw std::runtime_error("columns error");
+  void* ptrs[Size];
+  get_pointers<0>(row, ptrs);
+  for (size_t i(0); i < Size; ++i)
+  {
+    const int which(m_row[i].which());
+    if (which != m_which[i])
+    {
+      m_decoders[i] = resolvers[i](which);
+      m_which[i] = which;
+    }
+    m_nulls[i] = typeid(null_t) == m_row[i].type();
+    if (!m_decoders[i](m_row[i], ptrs[i])) throw std::runtime_error("type error");
+  }
+  return true;
+} // typed_rowset::
+
+} // brig
+
+#endif // BRIG_TYPED_ROWSET_HPP
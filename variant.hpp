@@ -5,7 +5,9 @@
 
 #include <boost/variant.hpp>
 #include <brig/blob_t.hpp>
+#include <brig/blob_view.hpp>
 #include <brig/null_t.hpp>
+#include <brig/string_view.hpp>
 #include <cstdint>
 #include <string>
 
@@ -19,7 +21,9 @@ typedef ::boost::variant<
   float,
   double,
   std::string,
-  blob_t
+  blob_t,
+  string_view, // borrowed, see rowset::fetch_view()
+  blob_view // borrowed, see rowset::fetch_view()
 > variant;
 
 } // brig